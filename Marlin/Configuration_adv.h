@@ -871,6 +871,97 @@
  */
 //#define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Step Schedule
+ *
+ * Work out the step timer intervals of the acceleration and deceleration
+ * of each block in the idle loop, ahead of time. The stepper ISR just reads
+ * them back, with no Bezier curve or division to evaluate on every step, for
+ * less ISR time and jitter. Blocks taken before their schedule is ready and
+ * ramps longer than the schedule are timed in the ISR as usual.
+ *
+ * Requires a 32-bit MCU. Takes 4 bytes per interval per block.
+ */
+//#define STEP_SCHEDULE
+#if ENABLED(STEP_SCHEDULE)
+  #define STEP_SCHEDULE_SIZE 64   // Intervals per block, up to half of them for the acceleration
+#endif
+
+/**
+ * Step Stream
+ *
+ * Run the step timing ahead of the motors and hand the HAL a ring of
+ * frames, each with the axes to step, their directions and the delay from
+ * the frame before. The HAL plays them back in batches, like the DMA
+ * buffers of I2S_STEPPER_STREAM, so the timing code no longer runs on the
+ * timer interrupt of every step. Quick stops and endstops act on frames
+ * not made yet, so they take effect up to STEP_STREAM_AHEAD later.
+ *
+ * Supported by LINUX. Not compatible with Input Shaping, Integrated
+ * Babystepping or Mixing Extruder.
+ */
+//#define STEP_STREAM
+#if ENABLED(STEP_STREAM)
+  #define STEP_STREAM_SIZE  512   // Frames in the ring, a power of 2. At least 256, or 512 with Linear Advance.
+  #define STEP_STREAM_BATCH  32   // Frames the HAL takes at a time
+  #define STEP_STREAM_AHEAD   2   // (ms) Most step time to hold in the ring
+#endif
+
+/**
+ * Stepper ISR Profile
+ *
+ * Time the stepper ISR and its pulse, block, Linear Advance, babystep and
+ * shaping phases, with the DWT cycle counter on Cortex-M3 and up or the
+ * step timer on other MCUs. M124 reports min/avg/p99/max per phase and the
+ * share of the CPU taken by the ISR. M124 R starts over.
+ *
+ * Adds a little time to every ISR, and ~130 bytes of RAM per phase.
+ */
+//#define STEPPER_ISR_PROFILE
+
+/**
+ * Planner Statistics
+ *
+ * Find where a stuttering print loses time. M123 reports how many moves
+ * were queued each time the stepper took a block, how often the planner
+ * ran dry while printing (and whether commands were waiting to be planned
+ * or the host / SD card was late), the time spent in recalculate(), and
+ * how many new blocks sent the reverse pass all the way back. M123 R
+ * starts over.
+ */
+//#define PLANNER_STATS
+
+/**
+ * Input Shaping
+ *
+ * Cancel the ringing of the X and Y axes at their resonant frequency, so
+ * they can run at a much higher acceleration. The stepper replays every
+ * X/Y step as 2 or 3 weighted impulses spread over a fraction of the
+ * ringing period, and drives the motor along the rounded sum.
+ *
+ * Find the frequency from a ringing tower printed with shaping off:
+ *   frequency = print speed / spacing of the ripples.
+ *
+ *  SHAPER_ZV  : Delays motion by 1/2 period. Needs an accurate frequency.
+ *  SHAPER_ZVD : Delays motion by 1 period. Tolerates a frequency error of about ±20%.
+ *  SHAPER_MZV : Delays motion by 3/4 period. Nearly as tolerant as ZVD.
+ *  SHAPER_EI  : Delays motion by 1 period. Keeps ringing under 5% over the widest band.
+ *
+ * Frequency, damping and shaper type can be changed with M593.
+ */
+//#define INPUT_SHAPING
+#if ENABLED(INPUT_SHAPING)
+  #define SHAPING_TYPE         SHAPER_MZV
+  #define SHAPING_FREQ_X       40     // (Hz) Resonant frequency of X. 0 to disable.
+  #define SHAPING_FREQ_Y       40     // (Hz) Resonant frequency of Y. 0 to disable.
+  #define SHAPING_ZETA_X       0.1    // Damping ratio of X, 0 to 0.5
+  #define SHAPING_ZETA_Y       0.1    // Damping ratio of Y, 0 to 0.5
+  #define SHAPING_MIN_FREQ     20     // (Hz) Lowest frequency M593 accepts
+  #define SHAPING_MAX_STEPRATE 20000  // (steps/s) Fastest X or Y step rate
+  // The last two size the buffer of steps awaiting replay, 4 bytes per step of the longest
+  // shaper per axis: 2 x 20000 steps/s x 1.16 / 20Hz = 9.3 kB at the defaults.
+#endif
+
 /**
  * Custom Microstepping
  * Override as-needed for your setup. Up to 3 MS pins are supported.
@@ -1520,6 +1611,8 @@
   //#define EXTRA_LIN_ADVANCE_K // Enable for second linear advance constants
   #define LIN_ADVANCE_K 0.25    // Unit: mm compression per 1mm/s extruder speed
   //#define LA_DEBUG            // If enabled, this will generate debug information output over USB.
+  //#define LA_MERGE_STEPS      // Send the E steps with the other axes' steps, without an advance ISR phase.
+                                // Advance follows the step rate. For 8-bit and Cortex-M3 boards.
 #endif
 
 // @section leveling
@@ -1638,6 +1731,16 @@
   #define N_ARC_CORRECTION       25 // Number of interpolated segments between corrections
   //#define ARC_P_CIRCLES           // Enable the 'P' parameter to specify complete circles
   //#define CNC_WORKSPACE_PLANES    // Allow G2/G3 to operate in XY, ZX, or YZ planes
+
+  /**
+   * Queue each XY arc as one planner block. The Stepper ISR steps X and Y
+   * along the same chords, working out each one as it comes, so a long arc
+   * takes a single buffer slot and is accelerated as one move.
+   * Arcs fall back to segments while bed leveling, XY skew correction or
+   * backlash compensation is on, outside the XY plane, and where the
+   * circle crosses a software endstop. Cartesian machines only.
+   */
+  //#define ARC_BLOCKS
 #endif
 
 // Support for G5 with XYZE destination and IJPQ offsets. Requires ~2666 bytes.
@@ -1659,6 +1762,23 @@
 // Moves (or segments) with fewer steps than this will be joined with the next move
 #define MIN_STEPS_PER_SEGMENT 6
 
+/**
+ * Coalesce collinear segments
+ *
+ * Slicers and arc interpolation can emit long runs of tiny segments that
+ * all point the same way. Queue a segment as part of the previous block
+ * when it continues in nearly the same direction, with nearly the same
+ * extrusion per mm, so the planner works on fewer, longer blocks.
+ * A block still waiting in the buffer is taken back and re-queued
+ * reaching to the end of the new segment.
+ */
+#define COALESCE_SEGMENTS
+#if ENABLED(COALESCE_SEGMENTS)
+  #define COALESCE_DEVIATION_MM 0.005 // (mm) Largest path deviation allowed by fusing two segments
+  #define COALESCE_E_RATIO      0.02  // Largest relative change in extrusion per mm
+  #define COALESCE_MAX_MM       10    // (mm) Longest block built from fused segments
+#endif
+
 /**
  * Minimum delay before and after setting the stepper DIR (in ns)
  *     0 : No delay (Expect at least 10µS since one Stepper ISR must transpire)
@@ -1721,12 +1841,44 @@
   #define BLOCK_BUFFER_SIZE 16 // maximize block buffer
 #endif
 
+/**
+ * Lookahead horizon
+ *
+ * Hold new moves back once the queued blocks add up to this much motion
+ * time, so the planner looks ahead over a span of time instead of a count
+ * of blocks. Pair it with a deep BLOCK_BUFFER_SIZE (64-256) on 32-bit and
+ * Linux targets: dense slicer output then fills enough blocks to reach full
+ * cornering speed, while long moves don't queue up many seconds of motion
+ * that a pause or a feedrate change has to wait through.
+ */
+//#define PLANNER_HORIZON_MS 250
+
+/**
+ * Fixed-point planner
+ *
+ * Plan junction speeds and acceleration trapezoids with integer math.
+ * On boards without an FPU (AVR, LPC1768, STM32F1) every float operation
+ * is a library call, and planning dense G-code falls behind. Speeds
+ * squared are kept in 1/256 (mm/s)^2, so no move may be faster than
+ * 4096 mm/s. Not useful on boards with an FPU.
+ */
+//#define PLANNER_FIXED_POINT
+
 // @section serial
 
 // The ASCII buffer for serial input
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
+/**
+ * Store the queued commands back to back in BUFSIZE_BYTES of RAM, each
+ * taking only its own length, instead of MAX_CMD_SIZE bytes apiece.
+ * A slicer's G1 line is about 35 bytes, so the same RAM holds twice as
+ * many moves, and more of the short commands. BUFSIZE still limits how
+ * many, so raise it too.
+ */
+//#define BUFSIZE_BYTES 384
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -1751,6 +1903,14 @@
 // Add M575 G-code to change the baud rate
 //#define BAUD_RATE_GCODE
 
+/**
+ * Binary motion stream, started with 'M28 B1'. The host sends G1 moves
+ * as packed fixed-point values in checksummed packets, and any other
+ * commands as text, so the moves skip line scanning and float parsing.
+ * See buildroot/share/scripts/binary_motion.py for the host side.
+ */
+//#define BINARY_MOTION
+
 #if ENABLED(SDSUPPORT)
   // Enable this option to collect and display the maximum
   // RX queue usage after transferring a file to SD.
@@ -1776,6 +1936,16 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+/**
+ * Credit-based flow control, so the host can keep many lines in flight
+ * instead of waiting for each "ok". Every "ok" names its line and adds
+ * C<n>, the highest line number the host may send so far, granted from
+ * the free command queue and RX buffer space. After a "Resend:" the lines
+ * already in flight are dropped silently until the requested line comes.
+ * See buildroot/share/scripts/serial_stream_bench.py --credits.
+ */
+//#define SERIAL_CREDITS
+
 // Printrun may have trouble receiving long strings all at once.
 // This option inserts short delays between lines of serial output.
 #define SERIAL_OVERRUN_PROTECTION
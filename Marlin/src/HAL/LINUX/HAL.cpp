@@ -26,6 +26,9 @@
 #include "../shared/Delay.h"
 
 HalSerial usb_serial;
+#ifdef SERIAL_PORT_2
+  HalSerial usb_serial2;
+#endif
 
 // U8glib required functions
 extern "C" void u8g_xMicroDelay(uint16_t val) {
@@ -42,6 +45,19 @@ extern "C" void u8g_Delay(uint16_t val) {
 }
 //************************//
 
+// HAL idle task
+void HAL_idletask() {
+  if (!simulation_running) simulation_exit();
+
+  // Under virtual time the firmware sleeps until the next scheduled event.
+  // On the wall clock, a short nap keeps an idle simulator off the CPU,
+  // timer signals still interrupt it.
+  if (Clock::virtualTime())
+    Scheduler::advanceToNext();
+  else
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
 // return free heap space
 int freeMemory() {
   return 0;
@@ -28,6 +28,7 @@
 #include <iostream>
 #include <stdint.h>
 #include <stdarg.h>
+#include <signal.h>
 
 #undef min
 #undef max
@@ -63,7 +64,13 @@ uint8_t _getc();
 
 extern HalSerial usb_serial;
 #define MYSERIAL0 usb_serial
-#define NUM_SERIAL 1
+#ifdef SERIAL_PORT_2
+  extern HalSerial usb_serial2;
+  #define MYSERIAL1 usb_serial2
+  #define NUM_SERIAL 2
+#else
+  #define NUM_SERIAL 1
+#endif
 
 #define ST7920_DELAY_1 DELAY_NS(600)
 #define ST7920_DELAY_2 DELAY_NS(750)
@@ -80,6 +87,26 @@ extern HalSerial usb_serial;
 
 inline void HAL_init() {}
 
+// Enable hooks into idle for HAL (advances virtual time)
+#define HAL_IDLETASK 1
+void HAL_idletask();
+
+// Benchmark hooks in the G-code, planner and stepper code
+#define HAL_BENCHMARK 1
+#include "hardware/Benchmark.h"
+
+// Commanded steps and stops of input-shaped axes, for the step analyzer (--step-stats)
+#define HAL_STEP_ANALYZER 1
+void HAL_commanded_step(const uint8_t axis, const bool forward);
+void HAL_shaping_stop(const uint8_t axis);
+
+// The step timer ISR plays STEP_STREAM frames, see step_stream.cpp
+#define HAL_STEP_STREAM 1
+
+// Simulator shutdown on SIGINT / SIGTERM, see main.cpp
+extern volatile sig_atomic_t simulation_running;
+[[noreturn]] void simulation_exit();
+
 // Utility functions
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
@@ -0,0 +1,137 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "Clock.h"
+#include "Benchmark.h"
+#include "../../../module/motion.h"
+#include "../../../module/planner.h"
+
+#if ENABLED(STEPPER_ISR_PROFILE)
+  #include "../../../feature/stepper_profile.h"
+#endif
+
+#if ENABLED(PLANNER_STATS)
+  #include "../../../module/stepper.h"
+#endif
+
+bool Benchmark::active = false;
+Benchmark::Timing Benchmark::parse, Benchmark::recalculate;
+uint64_t Benchmark::blocks = 0, Benchmark::starved = 0, Benchmark::coalesced = 0, Benchmark::shaping_overflows = 0,
+         Benchmark::unscheduled = 0, Benchmark::ramp_intervals = 0,
+         Benchmark::stream_frames = 0, Benchmark::stream_batches = 0;
+uint8_t Benchmark::queue_depth = 0;
+float Benchmark::position_error[4] = { 0 };
+int32_t Benchmark::trapezoid_step_error = 0;
+float Benchmark::trapezoid_rate_error = 0;
+uint64_t Benchmark::start_cpu = 0, Benchmark::start_time = 0;
+
+void Benchmark::start() {
+  start_cpu = cpuNanos();
+  start_time = Clock::nanos();
+  active = true;
+}
+
+// Where the G-code put the tool versus where the steppers took it,
+// seen through the same leveling / skew as set_current_from_steppers_for_axis()
+void Benchmark::samplePosition() {
+  get_cartesian_from_steppers();
+  xyze_pos_t pos = cartes;
+  pos.e = planner.get_axis_position_mm(E_AXIS);
+  #if HAS_POSITION_MODIFIERS
+    planner.unapply_modifiers(pos
+      #if HAS_LEVELING
+        , true
+      #endif
+    );
+  #endif
+  LOOP_XYZE(i) NOLESS(position_error[i], ABS(current_position[i] - pos[i]));
+}
+
+void Benchmark::report(FILE *out) {
+  const double cpu = (cpuNanos() - start_cpu) / 1e9,
+               printing = (Clock::nanos() - start_time) / 1e9;
+  auto rate = [](const uint64_t count, const double seconds) { return seconds > 0 ? count / seconds : 0.0; };
+  auto timing = [out](const char *name, const Timing &t, const char *tail) {
+    fprintf(out, "    \"%s\": { \"calls\": %llu, \"total_ms\": %.3f, \"avg_ns\": %.0f, \"max_ns\": %llu }%s\n",
+      name, (unsigned long long)t.calls, t.total_ns / 1e6, t.calls ? double(t.total_ns) / t.calls : 0.0, (unsigned long long)t.max_ns, tail);
+  };
+
+  fprintf(out, "{\n");
+  fprintf(out, "  \"print_seconds\": %.3f,\n", printing);
+  fprintf(out, "  \"cpu_seconds\": %.3f,\n", cpu);
+  fprintf(out, "  \"commands\": %llu,\n", (unsigned long long)parse.calls);
+  fprintf(out, "  \"commands_per_second\": %.1f,\n", rate(parse.calls, cpu));
+  fprintf(out, "  \"parse_per_second\": %.1f,\n", rate(parse.calls, parse.total_ns / 1e9));
+  // Every fused segment was counted as a block when it was first queued
+  fprintf(out, "  \"blocks\": %llu,\n", (unsigned long long)(blocks - coalesced));
+  fprintf(out, "  \"blocks_per_second\": %.1f,\n", rate(blocks - coalesced, cpu));
+  fprintf(out, "  \"coalesced_segments\": %llu,\n", (unsigned long long)coalesced);
+  fprintf(out, "  \"starvation_events\": %llu,\n", (unsigned long long)starved);
+  fprintf(out, "  \"queue_depth_max\": %d,\n", int(queue_depth));
+  fprintf(out, "  \"position_error_mm\": { \"X\": %.6f, \"Y\": %.6f, \"Z\": %.6f, \"E\": %.6f },\n",
+    position_error[X_AXIS], position_error[Y_AXIS], position_error[Z_AXIS], position_error[E_AXIS]);
+  #if ENABLED(INPUT_SHAPING)
+    fprintf(out, "  \"shaping_overflows\": %llu,\n", (unsigned long long)shaping_overflows);
+  #endif
+  #if ENABLED(STEP_SCHEDULE)
+    fprintf(out, "  \"step_schedule\": { \"unscheduled_blocks\": %llu, \"isr_ramp_intervals\": %llu },\n",
+      (unsigned long long)unscheduled, (unsigned long long)ramp_intervals);
+  #endif
+  #if ENABLED(STEP_STREAM)
+    fprintf(out, "  \"step_stream\": { \"frames\": %llu, \"batches\": %llu, \"frames_per_batch\": %.1f },\n",
+      (unsigned long long)stream_frames, (unsigned long long)stream_batches, stream_batches ? double(stream_frames) / stream_batches : 0.0);
+  #endif
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    {
+      const StepperProfile::phase_t &isr = StepperProfile::phase[PROFILE_ISR];
+      fprintf(out, "  \"isr_profile\": { \"calls\": %lu, \"pulse_calls\": %lu, \"block_calls\": %lu, \"avg_ns\": %.0f, \"p99_ns\": %lu, \"max_ns\": %lu, \"load_percent\": %.3f },\n",
+        (unsigned long)isr.calls, (unsigned long)StepperProfile::phase[PROFILE_PULSE].calls, (unsigned long)StepperProfile::phase[PROFILE_BLOCK].calls,
+        isr.calls ? double(isr.total) / isr.calls : 0.0, (unsigned long)StepperProfile::percentile(isr, 99), (unsigned long)isr.max,
+        StepperProfile::load_percent());
+    }
+  #endif
+  #if ENABLED(PLANNER_STATS)
+    {
+      const Planner::planner_stats_t &st = planner.stats;
+      uint32_t taken = 0;
+      fprintf(out, "  \"planner_stats\": { \"depth\": [");
+      LOOP_L_N(i, PLANNER_STATS_BINS) {
+        fprintf(out, "%s%lu", i ? ", " : "", (unsigned long)st.depth[i]);
+        taken += st.depth[i];
+      }
+      fprintf(out, "], \"blocks_taken\": %lu, \"starved\": %lu, \"starved_waiting\": %lu, \"recalculations\": %lu, \"reverse_passes\": %lu, \"full_reverse_passes\": %lu },\n",
+        (unsigned long)taken, (unsigned long)stepper.starved, (unsigned long)stepper.starved_waiting, (unsigned long)st.recalculations,
+        (unsigned long)st.reverse_passes, (unsigned long)(st.reverse_passes - st.short_reverse_passes));
+    }
+  #endif
+  #if ENABLED(PLANNER_FIXED_POINT)
+    fprintf(out, "  \"fixed_point\": { \"max_step_error\": %d, \"max_rate_error\": %.6f },\n", int(trapezoid_step_error), trapezoid_rate_error);
+  #endif
+  fprintf(out, "  \"timing\": {\n");
+  timing("parse", parse, ",");
+  timing("recalculate", recalculate, "");
+  fprintf(out, "  }\n}\n");
+}
+
+#endif // __PLAT_LINUX__
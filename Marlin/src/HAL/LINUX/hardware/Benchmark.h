@@ -0,0 +1,84 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * Firmware-side cost of a headless benchmark run (--bench)
+ *
+ * The G-code, planner and stepper code feed these through the
+ * HAL_BENCH_* hooks while a run is active. Timings are CPU time of the
+ * firmware thread, so neither waiting for the host nor simulated time
+ * is counted.
+ */
+class Benchmark {
+public:
+  struct Timing {
+    uint64_t calls = 0, total_ns = 0, max_ns = 0;
+  };
+
+  class Scope {
+  public:
+    Scope(Timing &timing) : timing(timing), start(active ? cpuNanos() : 0) {}
+    ~Scope() {
+      if (!active) return;
+      const uint64_t ns = cpuNanos() - start;
+      timing.calls++;
+      timing.total_ns += ns;
+      if (ns > timing.max_ns) timing.max_ns = ns;
+    }
+  private:
+    Timing &timing;
+    const uint64_t start;
+  };
+
+  static bool active;
+  static Timing parse, recalculate;
+  static uint64_t blocks, starved, coalesced;
+  static uint64_t shaping_overflows; // INPUT_SHAPING steps replayed early for lack of room
+  static uint64_t unscheduled, ramp_intervals; // STEP_SCHEDULE blocks and ramp ISR calls timed in the ISR
+  static uint64_t stream_frames, stream_batches; // STEP_STREAM frames played and batches taken
+  static uint8_t queue_depth; // Most commands queued at once
+  static float position_error[4]; // mm, XYZE
+  static int32_t trapezoid_step_error; // PLANNER_FIXED_POINT against float, steps
+  static float trapezoid_rate_error;   // and relative step rate
+
+  static uint64_t cpuNanos() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+  }
+
+  static void start();
+  static void samplePosition(); // with all motion done
+  static void report(FILE *out); // JSON
+
+private:
+  static uint64_t start_cpu, start_time;
+};
+
+#define HAL_BENCH_SCOPE(NAME) Benchmark::Scope bench_##NAME(Benchmark::NAME)
+#define HAL_BENCH_COUNT(NAME) do{ if (Benchmark::active) Benchmark::NAME++; }while(0)
+#define HAL_BENCH_ERROR(NAME, ERR) do{ if (Benchmark::active && (ERR) > Benchmark::NAME) Benchmark::NAME = (ERR); }while(0)
@@ -24,6 +24,8 @@
 #include <chrono>
 #include <thread>
 
+#include "Scheduler.h"
+
 class Clock {
 public:
   static uint64_t ticks(uint32_t frequency = Clock::frequency) {
@@ -45,6 +47,7 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
+    if (Clock::virtual_time) return Clock::virtual_nanos;
     auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
     return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
   }
@@ -62,18 +65,22 @@ public:
   }
 
   static void delayCycles(uint64_t cycles) {
+    if (Clock::virtual_time) return Scheduler::advance((1000000000L / frequency) * cycles);
     std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
   }
 
   static void delayMicros(uint64_t micros) {
+    if (Clock::virtual_time) return Scheduler::advance(micros * 1000);
     std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
   }
 
   static void delayMillis(uint64_t millis) {
+    if (Clock::virtual_time) return Scheduler::advance(millis * 1000000);
     std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
   }
 
   static void delaySeconds(double secs) {
+    if (Clock::virtual_time) return Scheduler::advance(secs * 1000000000.0);
     std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
   }
 
@@ -82,7 +89,21 @@ public:
     Clock::time_multiplier = tm;
   }
 
+  // Virtual time starts at zero and only moves when the Scheduler advances it,
+  // so runs are repeatable and not bound to wall-clock speed. Select before
+  // any timer is initialized; the time multiplier has no effect.
+  static void setVirtualTime(bool enable) {
+    Clock::virtual_time = enable;
+  }
+
+  static bool virtualTime() {
+    return Clock::virtual_time;
+  }
+
 private:
+  friend class Scheduler;
+  static bool virtual_time;
+  static uint64_t virtual_nanos;
   static std::chrono::nanoseconds startup;
   static uint32_t frequency;
   static double time_multiplier;
@@ -0,0 +1,81 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+/**
+ * Bounded lock-free queue, many producers and a single consumer
+ *
+ * push() may be called from any thread or timer "ISR" at once; it never
+ * blocks and only fails when the queue is full. pop() belongs to one
+ * consumer at a time. Each slot carries a sequence number telling whose
+ * turn it is, so producers only contend on the head index.
+ */
+template<typename T>
+class EventQueue {
+public:
+  EventQueue(uint32_t size) : ring(new Slot[size]), mask(size - 1) { // size must be a power of 2
+    for (uint32_t i = 0; i < size; i++) ring[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  bool push(const T &item) {
+    uint64_t pos = head.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = ring[pos & mask];
+      const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence == pos) {
+        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.item = item;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (sequence < pos)
+        return false; // the consumer is a whole ring behind
+      else
+        pos = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  bool pop(T &item) {
+    Slot &slot = ring[tail & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != tail + 1) return false;
+    item = slot.item;
+    slot.sequence.store(tail + mask + 1, std::memory_order_release);
+    tail++;
+    return true;
+  }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    T item;
+  };
+
+  std::unique_ptr<Slot[]> ring;
+  const uint64_t mask;
+  std::atomic<uint64_t> head { 0 };
+  uint64_t tail = 0;
+};
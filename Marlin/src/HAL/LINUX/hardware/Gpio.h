@@ -22,7 +22,9 @@
 #pragma once
 
 #include "Clock.h"
+#include "EventQueue.h"
 #include "../../../inc/MarlinConfigPre.h"
+#include <atomic>
 #include <stdint.h>
 
 typedef int16_t pin_type;
@@ -39,11 +41,13 @@ struct GpioEvent {
   uint64_t timestamp;
   pin_type pin_id;
   GpioEvent::Type event;
+  uint16_t value;   // pin value, mode or direction after the change
 
-  GpioEvent(uint64_t timestamp, pin_type pin_id, GpioEvent::Type event){
+  GpioEvent(uint64_t timestamp = 0, pin_type pin_id = 0, GpioEvent::Type event = NOP, uint16_t value = 0){
     this->timestamp = timestamp;
     this->pin_id = pin_id;
     this->event = event;
+    this->value = value;
   }
 };
 
@@ -53,18 +57,50 @@ public:
   virtual void log(GpioEvent ev) = 0;
 };
 
+/**
+ * Simulated hardware attached to pins
+ *
+ * By default the events of attached pins are only queued, lock-free, by
+ * whichever thread or timer "ISR" drove the pin. interrupt() sees them in
+ * order when the owner calls dispatch(), on the thread that also runs
+ * update(), so the model's state needs no locking. An immediate peripheral
+ * is interrupted in the writer's context instead, for models that must
+ * look at firmware state at the instant of the edge.
+ */
 class Peripheral {
 public:
+  Peripheral(bool immediate = false) : immediate(immediate) {}
   virtual ~Peripheral(){};
   virtual void interrupt(GpioEvent ev) = 0;
   virtual void update() = 0;
+
+  void deliver(const GpioEvent &ev) {
+    if (immediate) { interrupt(ev); return; }
+    // Full queue: drain it here, or wait for the owner to
+    while (!events.push(ev)) dispatch();
+  }
+
+  void dispatch() {
+    if (dispatching.test_and_set(std::memory_order_acquire)) return;
+    GpioEvent ev;
+    while (events.pop(ev)) interrupt(ev);
+    dispatching.clear(std::memory_order_release);
+  }
+
+protected:
+  bool immediate;
+
+private:
+  EventQueue<GpioEvent> events { 4096 };
+  std::atomic_flag dispatching = ATOMIC_FLAG_INIT;
 };
 
+// Shared by the firmware, its timer "ISRs" and the peripheral threads
 struct pin_data {
-  uint8_t dir;
-  uint8_t mode;
-  uint16_t value;
-  Peripheral* cb;
+  std::atomic<uint8_t> dir;
+  std::atomic<uint8_t> mode;
+  std::atomic<uint16_t> value;
+  std::atomic<Peripheral*> cb;
 };
 
 class Gpio {
@@ -81,55 +117,55 @@ public:
     set(pin, 1);
   }
 
+  // Each pin has a single writer at a time, the value needs no read-modify-write
   static void set(pin_type pin, uint16_t value) {
     if (!valid_pin(pin)) return;
-    GpioEvent::Type evt_type = value > 1 ? GpioEvent::SET_VALUE : value > pin_map[pin].value ? GpioEvent::RISE : value < pin_map[pin].value ? GpioEvent::FALL : GpioEvent::NOP;
-    pin_map[pin].value = value;
-    GpioEvent evt(Clock::nanos(), pin, evt_type);
-    if (pin_map[pin].cb != nullptr) {
-      pin_map[pin].cb->interrupt(evt);
-    }
-    if (Gpio::logger != nullptr) Gpio::logger->log(evt);
+    const uint16_t old = pin_map[pin].value.load(std::memory_order_relaxed);
+    GpioEvent::Type evt_type = value > 1 ? GpioEvent::SET_VALUE : value > old ? GpioEvent::RISE : value < old ? GpioEvent::FALL : GpioEvent::NOP;
+    pin_map[pin].value.store(value, std::memory_order_relaxed);
+    notify(GpioEvent(Clock::nanos(), pin, evt_type, value));
   }
 
   static uint16_t get(pin_type pin) {
     if (!valid_pin(pin)) return 0;
-    return pin_map[pin].value;
+    return pin_map[pin].value.load(std::memory_order_relaxed);
   }
 
   static void clear(pin_type pin) {
     set(pin, 0);
   }
 
+  // Level a peripheral presents on an input pin (endstop, ADC), no event
+  static void drive(pin_type pin, uint16_t value) {
+    if (!valid_pin(pin)) return;
+    pin_map[pin].value.store(value, std::memory_order_relaxed);
+  }
+
   static void setMode(pin_type pin, uint8_t value) {
     if (!valid_pin(pin)) return;
-    pin_map[pin].mode = value;
-    GpioEvent evt(Clock::nanos(), pin, GpioEvent::Type::SETM);
-    if (pin_map[pin].cb != nullptr) pin_map[pin].cb->interrupt(evt);
-    if (Gpio::logger != nullptr) Gpio::logger->log(evt);
+    pin_map[pin].mode.store(value, std::memory_order_relaxed);
+    notify(GpioEvent(Clock::nanos(), pin, GpioEvent::Type::SETM, value));
   }
 
   static uint8_t getMode(pin_type pin) {
     if (!valid_pin(pin)) return 0;
-    return pin_map[pin].mode;
+    return pin_map[pin].mode.load(std::memory_order_relaxed);
   }
 
   static void setDir(pin_type pin, uint8_t value) {
     if (!valid_pin(pin)) return;
-    pin_map[pin].dir = value;
-    GpioEvent evt(Clock::nanos(), pin, GpioEvent::Type::SETD);
-    if (pin_map[pin].cb != nullptr) pin_map[pin].cb->interrupt(evt);
-    if (Gpio::logger != nullptr) Gpio::logger->log(evt);
+    pin_map[pin].dir.store(value, std::memory_order_relaxed);
+    notify(GpioEvent(Clock::nanos(), pin, GpioEvent::Type::SETD, value));
   }
 
   static uint8_t getDir(pin_type pin) {
     if (!valid_pin(pin)) return 0;
-    return pin_map[pin].dir;
+    return pin_map[pin].dir.load(std::memory_order_relaxed);
   }
 
   static void attachPeripheral(pin_type pin, Peripheral* per) {
     if (!valid_pin(pin)) return;
-    pin_map[pin].cb = per;
+    pin_map[pin].cb.store(per, std::memory_order_release);
   }
 
   static void attachLogger(IOLogger* logger) {
@@ -137,5 +173,11 @@ public:
   }
 
 private:
+  static void notify(const GpioEvent &evt) {
+    Peripheral *cb = pin_map[evt.pin_id].cb.load(std::memory_order_acquire);
+    if (cb != nullptr) cb->deliver(evt);
+    if (Gpio::logger != nullptr) Gpio::logger->log(evt);
+  }
+
   static IOLogger* logger;
 };
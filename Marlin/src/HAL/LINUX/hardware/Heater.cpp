@@ -23,39 +23,103 @@
 #ifdef __PLAT_LINUX__
 
 #include "Clock.h"
-#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "../../../inc/MarlinConfig.h"
 
 #include "Heater.h"
 
-Heater::Heater(pin_t heater, pin_t adc) {
-  heater_state = 0;
-  room_temp_raw = 150;
-  last = Clock::micros();
+ThermalModel ThermalModel::bed() {
+  ThermalModel bed;
+  bed.power = 200;
+  bed.capacity = 350;
+  bed.loss = 1.5;
+  bed.fan_loss = 0;
+  bed.filament = 0;
+  return bed;
+}
+
+bool ThermalModel::parse(const char *spec) {
+  static const struct { const char *name; double ThermalModel::*value; } keys[] = {
+    { "power", &ThermalModel::power }, { "capacity", &ThermalModel::capacity },
+    { "loss", &ThermalModel::loss }, { "fan_loss", &ThermalModel::fan_loss },
+    { "filament", &ThermalModel::filament }, { "ambient", &ThermalModel::ambient },
+    { "r25", &ThermalModel::r25 }, { "beta", &ThermalModel::beta },
+    { "pullup", &ThermalModel::pullup }, { "noise", &ThermalModel::noise }
+  };
+  while (*spec) {
+    const char *eq = strchr(spec, '='), *end = strchrnul(spec, ',');
+    if (!eq || eq > end) return false;
+    char *num_end;
+    const double value = strtod(eq + 1, &num_end);
+    if (num_end != end) return false;
+    bool found = false;
+    for (auto &key : keys)
+      if (strlen(key.name) == size_t(eq - spec) && !strncmp(key.name, spec, eq - spec)) {
+        this->*key.value = value;
+        found = true;
+      }
+    if (!found) return false;
+    spec = *end ? end + 1 : end;
+  }
+  return true;
+}
+
+void DutyMeter::change(const uint64_t now, const double new_level) {
+  high += (now - level_since) * level;
+  level_since = now;
+  level = new_level;
+}
+
+double DutyMeter::read(const uint64_t now) {
+  change(now, level);
+  const double duty = now > since ? double(high) / (now - since) : level;
+  since = now;
+  high = 0;
+  return duty;
+}
+
+Heater::Heater(pin_t heater, pin_t adc, pin_t fan, const ThermalModel &model) : model(model), adc_noise(0, model.noise) {
   heater_pin = heater;
   adc_pin = adc;
-  heat = 0.0;
+  fan_pin = fan;
+  temperature = model.ambient;
+  extruded = 0;
+  last = Clock::nanos();
+  heater_duty.since = heater_duty.level_since = fan_duty.since = fan_duty.level_since = last;
+
+  Gpio::attachPeripheral(heater_pin, this);
+  Gpio::attachPeripheral(fan_pin, this);
 }
 
 Heater::~Heater() {
 }
 
 void Heater::update() {
-  // crude pwm read and cruder heat simulation
-  auto now = Clock::micros();
-  double delta = (now - last);
-  if (delta > 1000 ) {
-    heater_state = pwmcap.update(0xFFFF * Gpio::pin_map[heater_pin].value);
-    last = now;
-    heat += (heater_state - heat) * (delta / 1000000000.0);
-
-    NOLESS(heat, room_temp_raw);
-    Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = 0xFFFF - (uint16_t)heat;
-  }
+  const uint64_t now = Clock::nanos();
+  if (now - last < 1000000) return;
+  const double dt = (now - last) / 1e9;
+  last = now;
+
+  const double rise = temperature - model.ambient,
+               loss = (model.loss + model.fan_loss * fan_duty.read(now)) * rise + model.filament * extruded / dt * rise;
+  temperature += (model.power * heater_duty.read(now) - loss) * dt / model.capacity;
+  extruded = 0;
+
+  // NTC in a pull-up divider, sampled by a 12-bit ADC
+  const double r = model.r25 * exp(model.beta * (1 / (temperature + 273.15) - 1 / 298.15));
+  double counts = 4095 * r / (r + model.pullup);
+  if (model.noise > 0) counts += adc_noise(rng);
+  Gpio::drive(analogInputToDigitalPin(adc_pin), (uint16_t)constrain(lround(counts), 0, 4095));
 }
 
 void Heater::interrupt(GpioEvent ev) {
-  // ununsed
+  if (ev.event == GpioEvent::SETM || ev.event == GpioEvent::SETD) return;
+  // analogWrite() sets 0-255, soft PWM toggles 0 / 1
+  const double level = ev.event == GpioEvent::SET_VALUE ? ev.value / 255.0 : ev.value;
+  if (ev.pin_id == heater_pin) heater_duty.change(ev.timestamp, level);
+  else if (ev.pin_id == fan_pin) fan_duty.change(ev.timestamp, level);
 }
 
 #endif // __PLAT_LINUX__
@@ -21,27 +21,56 @@
  */
 #pragma once
 
+#include <random>
 #include "Gpio.h"
 
-struct LowpassFilter {
-  uint64_t data_delay = 0;
-  uint16_t update(uint16_t value) {
-    data_delay = data_delay - (data_delay >> 6) + value;
-    return (uint16_t)(data_delay >> 6);
-  }
+/**
+ * Lumped thermal mass of a heater block or bed
+ *
+ * Energy in from the heater cartridge, out to the ambient air (more so
+ * with the part cooling fan running) and into the filament pushed
+ * through the nozzle. The temperature is read back through an NTC
+ * thermistor in a pull-up divider, with Gaussian ADC noise.
+ */
+struct ThermalModel {
+  double power = 40;         // W, heater at full duty
+  double capacity = 12;      // J/K
+  double loss = 0.15;        // W/K to ambient
+  double fan_loss = 0.05;    // W/K more with the fan at full duty
+  double filament = 0.0022;  // J/(K mm³), PLA
+  double ambient = 25;       // °C
+  double r25 = 100000;       // Ω, thermistor at 25°C
+  double beta = 4267;        // K, thermistor beta
+  double pullup = 4700;      // Ω
+  double noise = 1;          // 12-bit ADC counts RMS
+
+  static ThermalModel bed();
+  bool parse(const char *spec); // key=value[,key=value...]
+};
+
+// Time-weighted average of a PWM pin between two reads
+struct DutyMeter {
+  uint64_t since = 0, high = 0, level_since = 0;
+  double level = 0;
+
+  void change(uint64_t now, double new_level);
+  double read(uint64_t now);
 };
 
 class Heater: public Peripheral {
 public:
-  Heater(pin_t heater, pin_t adc);
+  Heater(pin_t heater, pin_t adc, pin_t fan, const ThermalModel &model);
   virtual ~Heater();
   void interrupt(GpioEvent ev);
   void update();
+  void extrude(double volume) { extruded += volume; } // mm³
 
-  pin_t heater_pin, adc_pin;
-  uint16_t room_temp_raw;
-  uint16_t heater_state;
-  LowpassFilter pwmcap;
-  double heat;
+  pin_t heater_pin, adc_pin, fan_pin;
+  ThermalModel model;
+  double temperature;        // °C
+  double extruded;           // mm³ since the last update
+  DutyMeter heater_duty, fan_duty;
   uint64_t last;
+  std::mt19937 rng;
+  std::normal_distribution<double> adc_noise;
 };
@@ -0,0 +1,234 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "HostPort.h"
+#include "Timer.h"
+
+static bool write_all(int fd, const uint8_t *data, std::size_t len) {
+  while (len) {
+    const ssize_t written = ::write(fd, data, len);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN) {
+        // Nobody is draining the terminal, give up rather than stall the firmware
+        struct pollfd pfd = { fd, POLLOUT, 0 };
+        if (poll(&pfd, 1, 100) > 0) continue;
+      }
+      return false;
+    }
+    data += written;
+    len -= written;
+  }
+  return true;
+}
+
+HostPort::~HostPort() {
+  if (!link.empty()) unlink(link.c_str());
+  if (type == SOCKET) unlink(path.c_str());
+}
+
+bool HostPort::open(const std::string &spec) {
+  if (spec == "stdio") {
+    type = STDIO;
+    in_fd = STDIN_FILENO;
+    out_fd = STDOUT_FILENO;
+    conn_fd = STDIN_FILENO;
+    return true;
+  }
+
+  if (spec.compare(0, 3, "pty") == 0) {
+    type = PTY;
+    const int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0) return false;
+    path = ptsname(master);
+
+    // Hold the slave open so the master doesn't see EIO between clients
+    slave_fd = ::open(path.c_str(), O_RDWR | O_NOCTTY);
+    if (slave_fd < 0) return false;
+    struct termios tio;
+    tcgetattr(slave_fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave_fd, TCSANOW, &tio);
+
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    in_fd = out_fd = master;
+    conn_fd = master;
+
+    if (spec.size() > 4 && spec[3] == ':') {
+      link = spec.substr(4);
+      unlink(link.c_str());
+      if (symlink(path.c_str(), link.c_str()) < 0) return false;
+    }
+    return true;
+  }
+
+  if (spec.compare(0, 5, "unix:") == 0) {
+    type = SOCKET;
+    path = spec.substr(5);
+    struct sockaddr_un addr = {};
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    addr.sun_family = AF_UNIX;
+    path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0
+      || bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0
+      || listen(listen_fd, 1) < 0
+    ) return false;
+    serial.host_connected = false; // output is dropped until a client attaches
+    return true;
+  }
+
+  return false;
+}
+
+std::string HostPort::name() const {
+  switch (type) {
+    case PTY:    return link.empty() ? path : link + " -> " + path;
+    case SOCKET: return "unix:" + path;
+    default:     return "stdio";
+  }
+}
+
+void HostPort::start() {
+  write_thread = std::thread(&HostPort::writer, this);
+  read_thread = std::thread(&HostPort::reader, this);
+}
+
+void HostPort::start(std::function<bool()> may_wait) {
+  write_thread = std::thread(&HostPort::writer, this);
+  this->may_wait = may_wait;
+  serial.underflow = [this]{ underflow(); };
+}
+
+// Block until a host is attached and return its descriptor
+int HostPort::connection() {
+  int fd = conn_fd;
+  if (fd >= 0 || type != SOCKET) return fd;
+  fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+  if (fd < 0) return -1;
+  conn_fd = fd;
+  serial.host_connected = true;
+  return fd;
+}
+
+void HostPort::disconnect(int fd) {
+  if (type != SOCKET) return;
+  serial.host_connected = false;
+  conn_fd = -1;
+  close(fd);
+}
+
+void HostPort::reader() {
+  Timer::blockSignals();
+  uint8_t buffer[4096];
+  for (;;) {
+    const int fd = connection();
+    if (fd < 0) return;
+    if (type == PTY) {
+      struct pollfd pfd = { fd, POLLIN, 0 };
+      if (poll(&pfd, 1, -1) < 0) continue;
+    }
+    const ssize_t len = ::read(fd, buffer, sizeof(buffer));
+    if (len < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+    if (len <= 0) {
+      if (type != SOCKET) return; // host closed stdin
+      disconnect(fd);
+      continue;
+    }
+    for (ssize_t i = 0; i < len; i++) {
+      serial.rx_space.wait([this]{ return !serial.receive_buffer.full(); });
+      serial.receive_buffer.write(buffer[i]);
+    }
+  }
+}
+
+// Drain the transmit buffer to the host in batches, sleeping while it is empty
+void HostPort::writer() {
+  Timer::blockSignals();
+  uint8_t buffer[4096];
+  for (;;) {
+    serial.tx_data.wait([this]{ return !serial.transmit_buffer.empty(); });
+    std::size_t len = 0;
+    while (len < sizeof(buffer) && !serial.transmit_buffer.empty())
+      buffer[len++] = serial.transmit_buffer.read();
+    serial.tx_space.notify();
+    const int fd = type == STDIO ? out_fd : conn_fd.load();
+    if (fd >= 0 && !write_all(fd, buffer, len) && type == STDIO)
+      serial.host_connected = false;
+  }
+}
+
+bool HostPort::drained() {
+  return eof && pending.empty() && serial.receive_buffer.empty();
+}
+
+// Virtual time: hand the firmware one line each time it runs dry. Blocking
+// for the host only when may_wait() says the firmware is otherwise idle
+// keeps "ok" paced hosts from deadlocking and makes the interleaving of
+// input and firmware activity repeatable. Virtual time stands still while
+// waiting for the host; a caught signal ends the wait early.
+void HostPort::underflow() {
+  for (;;) {
+    const std::size_t eol = pending.find('\n');
+    if (eol != std::string::npos || (eof && !pending.empty())) {
+      const std::size_t len = std::min(eol == std::string::npos ? pending.size() : eol + 1, (std::size_t)serial.receive_buffer.free());
+      for (std::size_t i = 0; i < len; i++) serial.receive_buffer.write(pending[i]);
+      pending.erase(0, len);
+      return;
+    }
+    if (eof || !may_wait()) return;
+
+    char buffer[4096];
+    const int fd = connection();
+    if (fd < 0) {
+      if (errno == EINTR) return; // let the firmware see the signal
+      eof = true;
+      continue;
+    }
+    if (type == PTY) {
+      struct pollfd pfd = { fd, POLLIN, 0 };
+      if (poll(&pfd, 1, -1) < 0 && errno == EINTR) return;
+    }
+    const ssize_t len = ::read(fd, buffer, sizeof(buffer));
+    if (len < 0 && errno == EINTR) return;
+    if (len < 0 && errno == EAGAIN) continue;
+    if (len <= 0) {
+      if (type == SOCKET) { disconnect(fd); continue; }
+      eof = true;
+      continue;
+    }
+    pending.append(buffer, len);
+  }
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,75 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "../include/serial.h"
+
+/**
+ * Host side of a simulated serial port
+ *
+ * Connects a HalSerial to the outside world and moves data in batches
+ * with one reader and one writer thread:
+ *
+ *   stdio        stdin / stdout
+ *   pty[:LINK]   a pseudo-terminal, optionally symlinked to LINK
+ *   unix:PATH    a listening UNIX socket, one client at a time
+ *
+ * Under virtual time the first port is read in lock-step instead: one
+ * line per underflow of the firmware's receive buffer, waiting for the
+ * host only once the firmware has nothing left to do.
+ */
+class HostPort {
+public:
+  enum Type { STDIO, PTY, SOCKET };
+
+  HostPort(HalSerial &serial) : serial(serial) {}
+  virtual ~HostPort();
+
+  bool open(const std::string &spec);
+  void start();
+  void start(std::function<bool()> may_wait); // lock-step
+
+  std::string name() const;
+  bool drained(); // lock-step: the host is done and all its input was read
+
+private:
+  void reader();
+  void writer();
+  void underflow();
+  int connection();
+  void disconnect(int fd);
+
+  HalSerial &serial;
+  Type type = STDIO;
+  std::string path, link;
+  int in_fd = -1, out_fd = -1, listen_fd = -1, slave_fd = -1;
+  std::atomic<int> conn_fd { -1 };
+  std::thread read_thread, write_thread;
+
+  // Lock-step line assembly
+  std::function<bool()> may_wait;
+  std::string pending;
+  bool eof = false;
+};
@@ -0,0 +1,106 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "IOLoggerBinary.h"
+
+static constexpr std::size_t initial_map_size = 16 * 1024 * 1024;
+
+static inline uint64_t zigzag(int64_t v) { return (uint64_t(v) << 1) ^ uint64_t(v >> 63); }
+
+IOLoggerBinary::IOLoggerBinary(std::string filename, uint32_t ring_size) : ring(ring_size) {
+  fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) return;
+  mapped = initial_map_size;
+  if (ftruncate(fd, mapped) < 0) { close(fd); fd = -1; return; }
+  map = (uint8_t*)mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) { map = nullptr; close(fd); fd = -1; return; }
+
+  Header *header = (Header*)map;
+  memcpy(header->magic, "MRLNGPIO", sizeof(header->magic));
+  header->version = version;
+  header->header_size = sizeof(Header);
+  used = sizeof(Header);
+}
+
+IOLoggerBinary::~IOLoggerBinary() {
+  flush();
+  if (map) munmap(map, mapped);
+  if (fd >= 0) {
+    if (ftruncate(fd, used) < 0) { /* keep the padded file, data_bytes marks the end */ }
+    close(fd);
+  }
+}
+
+void IOLoggerBinary::log(GpioEvent ev) {
+  // Drop the event if the consumer is a whole ring behind
+  if (!ring.push(ev)) dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void IOLoggerBinary::reserve(std::size_t bytes) {
+  if (used + bytes <= mapped) return;
+  const std::size_t grow = mapped * 2;
+  if (ftruncate(fd, grow) < 0) return;
+  void *remapped = mremap(map, mapped, grow, MREMAP_MAYMOVE);
+  if (remapped == MAP_FAILED) return;
+  map = (uint8_t*)remapped;
+  mapped = grow;
+}
+
+void IOLoggerBinary::put(uint64_t value) {
+  while (value >= 0x80) {
+    map[used++] = uint8_t(value) | 0x80;
+    value >>= 7;
+  }
+  map[used++] = uint8_t(value);
+}
+
+void IOLoggerBinary::flush() {
+  if (!map) return;
+  GpioEvent ev;
+  for (;;) {
+    reserve(32);
+    if (used + 32 > mapped) break; // out of disk, stop here
+    if (!ring.pop(ev)) break;
+
+    const bool implied = (ev.event == GpioEvent::RISE && ev.value == 1) || (ev.event == GpioEvent::FALL && ev.value == 0);
+    map[used++] = ev.event | (implied ? 0 : 0x08);
+    put(zigzag(int64_t(ev.timestamp - last_timestamp)));
+    put(zigzag(int64_t(ev.pin_id) - last_pin));
+    if (!implied) put(ev.value);
+    last_timestamp = ev.timestamp;
+    last_pin = ev.pin_id;
+  }
+
+  // Keep the header current, a simulator is usually stopped by a signal
+  Header *header = (Header*)map;
+  header->data_bytes = used - sizeof(Header);
+  header->dropped = dropped.load(std::memory_order_relaxed);
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,75 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <string>
+#include "EventQueue.h"
+#include "Gpio.h"
+
+/**
+ * Binary GPIO trace
+ *
+ * log() may be called from any thread or timer "ISR": events go into a
+ * bounded lock-free ring and are dropped (and counted) if it overflows,
+ * so tracing never stalls step generation. flush() drains the ring into
+ * a memory-mapped file, one compact record per event:
+ *
+ *   uint8   event type (bits 0-2), explicit value follows (bit 3)
+ *   varint  zigzag timestamp delta, ns
+ *   varint  zigzag pin delta
+ *   varint  value, if bit 3 is set (RISE/FALL otherwise imply 1/0)
+ *
+ * behind a fixed header. buildroot/share/scripts/gpio_trace_decode.py
+ * converts a trace to CSV or VCD.
+ */
+class IOLoggerBinary: public IOLogger {
+public:
+  struct Header {
+    char magic[8];        // "MRLNGPIO"
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t data_bytes;  // encoded records following the header
+    uint64_t dropped;     // events lost to ring overflow
+  };
+
+  static constexpr uint32_t version = 1;
+
+  IOLoggerBinary(std::string filename, uint32_t ring_size = 1 << 16); // ring_size must be a power of 2
+  virtual ~IOLoggerBinary();
+  void flush();
+  void log(GpioEvent ev);
+
+private:
+  void reserve(std::size_t bytes);
+  void put(uint64_t value);
+
+  EventQueue<GpioEvent> ring;
+  std::atomic<uint64_t> dropped { 0 };
+
+  // Mapped output file
+  int fd = -1;
+  uint8_t *map = nullptr;
+  std::size_t mapped = 0, used = 0;
+  uint64_t last_timestamp = 0;
+  pin_type last_pin = 0;
+};
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include "Clock.h"
 #include "LinearAxis.h"
+#include "StepAnalyzer.h"
 
 LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max) {
   enable_pin = enable;
@@ -38,7 +39,11 @@ LinearAxis::LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type en
   max_position = (200*80) + min_position;
   position = rand() % ((max_position - 40) - min_position) + (min_position + 20);
   last_update = Clock::nanos();
+  enabled = !Gpio::get(enable_pin);
+  forward = Gpio::get(dir_pin);
 
+  Gpio::attachPeripheral(enable_pin, this);
+  Gpio::attachPeripheral(dir_pin, this);
   Gpio::attachPeripheral(step_pin, this);
 
 }
@@ -52,13 +57,17 @@ void LinearAxis::update() {
 }
 
 void LinearAxis::interrupt(GpioEvent ev) {
-  if (ev.pin_id == step_pin && !Gpio::pin_map[enable_pin].value){
+  if (ev.event == GpioEvent::SETM || ev.event == GpioEvent::SETD) return;
+  if (ev.pin_id == enable_pin) enabled = !ev.value;
+  else if (ev.pin_id == dir_pin) forward = ev.value;
+  else if (ev.pin_id == step_pin && enabled){
     if (ev.event == GpioEvent::RISE) {
       last_update = ev.timestamp;
-      position += -1 + 2 * Gpio::pin_map[dir_pin].value;
-      Gpio::pin_map[min_pin].value = (position < min_position);
-      //Gpio::pin_map[max_pin].value = (position > max_position);
-      //if (position < min_position) printf("axis(%d) endstop : pos: %d, mm: %f, min: %d\n", step_pin, position, position / 80.0, Gpio::pin_map[min_pin].value);
+      if (analyzer) analyzer->step(motor, ev.timestamp, forward);
+      const int32_t now_at = position.load(std::memory_order_relaxed) + (forward ? 1 : -1);
+      position.store(now_at, std::memory_order_relaxed);
+      Gpio::drive(min_pin, now_at < min_position);
+      //Gpio::drive(max_pin, now_at > max_position);
     }
   }
 }
@@ -21,15 +21,20 @@
  */
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include "Gpio.h"
 
+class StepAnalyzer;
+
 class LinearAxis: public Peripheral {
 public:
   LinearAxis(pin_type enable, pin_type dir, pin_type step, pin_type end_min, pin_type end_max);
   virtual ~LinearAxis();
   void update();
   void interrupt(GpioEvent ev);
+  // The analyzer matches steps against the block being executed, so it runs in the stepper ISR
+  void attachAnalyzer(StepAnalyzer *analyzer, uint8_t motor) { this->analyzer = analyzer; this->motor = motor; immediate = true; }
 
   pin_type enable_pin;
   pin_type dir_pin;
@@ -37,9 +42,13 @@ public:
   pin_type min_pin;
   pin_type max_pin;
 
-  int32_t position;
+  std::atomic<int32_t> position;
   int32_t min_position;
   int32_t max_position;
   uint64_t last_update;
+  bool enabled, forward;   // driver state as of the last event
+
+  StepAnalyzer *analyzer = nullptr;
+  uint8_t motor = 0;
 
 };
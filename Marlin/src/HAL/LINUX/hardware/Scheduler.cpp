@@ -0,0 +1,86 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include <algorithm>
+#include "Clock.h"
+#include "Scheduler.h"
+
+std::vector<ScheduledEvent*> Scheduler::events;
+bool Scheduler::in_dispatch = false;
+
+// With nothing scheduled, idle time still has to pass for millis() based waits
+static constexpr uint64_t idle_quantum_ns = 1000000;
+
+void Scheduler::attach(ScheduledEvent* ev) {
+  if (std::find(events.begin(), events.end(), ev) == events.end())
+    events.push_back(ev);
+}
+
+void Scheduler::detach(ScheduledEvent* ev) {
+  events.erase(std::remove(events.begin(), events.end(), ev), events.end());
+}
+
+// Only a handful of sources exist, so a linear scan beats a heap. Ties go to
+// the earliest attached source, which keeps the firing order reproducible.
+static ScheduledEvent* earliest(const std::vector<ScheduledEvent*> &events) {
+  ScheduledEvent* next = nullptr;
+  for (auto ev : events)
+    if (ev->deadline != ScheduledEvent::never && (!next || ev->deadline < next->deadline))
+      next = ev;
+  return next;
+}
+
+uint64_t Scheduler::nextDeadline() {
+  ScheduledEvent* next = earliest(events);
+  return next ? next->deadline : ScheduledEvent::never;
+}
+
+void Scheduler::advance(uint64_t ns) {
+  advanceTo(Clock::virtual_nanos + ns);
+}
+
+void Scheduler::advanceTo(uint64_t ns) {
+  if (in_dispatch) {
+    // Called from inside an event (e.g. a delay in an ISR): time passes, nothing preempts
+    Clock::virtual_nanos = std::max(Clock::virtual_nanos, ns);
+    return;
+  }
+
+  in_dispatch = true;
+  for (;;) {
+    ScheduledEvent* next = earliest(events);
+    if (!next || next->deadline > std::max(ns, Clock::virtual_nanos)) break;
+    Clock::virtual_nanos = std::max(Clock::virtual_nanos, next->deadline);
+    next->fire();
+  }
+  Clock::virtual_nanos = std::max(Clock::virtual_nanos, ns);
+  in_dispatch = false;
+}
+
+void Scheduler::advanceToNext() {
+  const uint64_t next = nextDeadline();
+  advanceTo(next == ScheduledEvent::never ? Clock::virtual_nanos + idle_quantum_ns : std::max(next, Clock::virtual_nanos));
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,76 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+/**
+ * Discrete-event scheduler for virtual time
+ *
+ * Every source of simulated activity (timers, peripheral updates) registers
+ * a deadline in virtual nanoseconds. Advancing the clock fires each source
+ * whose deadline has passed, in deadline order, with Clock::nanos() set to
+ * that deadline. Time consumed while a source is running (delays, counter
+ * reads inside an ISR) moves the clock but defers other due sources until
+ * the running one returns, the way a pending interrupt waits for the
+ * current ISR to finish.
+ */
+class ScheduledEvent {
+public:
+  static constexpr uint64_t never = UINT64_MAX;
+
+  virtual ~ScheduledEvent() {}
+  virtual void fire() = 0;  // Called with Clock::nanos() == deadline. Must move the deadline forward.
+
+  uint64_t deadline = never;
+};
+
+class PeriodicEvent: public ScheduledEvent {
+public:
+  PeriodicEvent(uint64_t period_ns, std::function<void()> fn) : period(period_ns), callback(fn) {}
+  void start(uint64_t now) { deadline = now + period; }
+  void fire() { deadline += period; callback(); }
+
+private:
+  uint64_t period;
+  std::function<void()> callback;
+};
+
+class Scheduler {
+public:
+  static void attach(ScheduledEvent* ev);
+  static void detach(ScheduledEvent* ev);
+
+  static uint64_t nextDeadline();
+
+  static void advance(uint64_t ns);       // Let ns pass, firing everything that comes due
+  static void advanceTo(uint64_t ns);     // Let time pass up to an absolute timestamp
+  static void advanceToNext();            // Jump to (and fire) the next pending event
+
+  static bool dispatching() { return in_dispatch; }
+
+private:
+  static std::vector<ScheduledEvent*> events;
+  static bool in_dispatch;
+};
@@ -0,0 +1,310 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include <math.h>
+#include "../../../inc/MarlinConfig.h"
+#include "../../../module/planner.h"
+#include "../../../module/stepper.h"
+#include "StepAnalyzer.h"
+
+const uint32_t StepAnalyzer::bin_edges[bins] = { 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000 };
+
+StepAnalyzer::StepAnalyzer(uint64_t deadline_ns) : deadline_ns(deadline_ns) {}
+
+// Time to cover n steps while the rate follows the stepper's 5th order
+// Bezier from va to vb over T seconds, continuing at vb beyond T.
+static double ramp_time(const double n, const double va, const double vb, const double T) {
+  auto distance = [=](const double t) {
+    const double x = t / T;
+    return va * t + (vb - va) * T * x * x * x * x * (2.5 - 3 * x + x * x);
+  };
+  if (T <= 0) return n / vb;
+  const double end = distance(T);
+  if (n >= end) return T + (n - end) / vb;
+  double lo = 0, hi = T;
+  for (uint8_t i = 0; i < 48; i++) {
+    const double mid = (lo + hi) / 2;
+    (distance(mid) < n ? lo : hi) = mid;
+  }
+  return (lo + hi) / 2;
+}
+
+void StepAnalyzer::Profile::load(const block_t *block) {
+  step_event_count = block->step_event_count;
+  accelerate_until = block->accelerate_until;
+  decelerate_after = block->decelerate_after;
+  LOOP_L_N(i, motors) steps[i] = block->steps[i];
+  v0 = block->initial_rate;
+  vf = block->final_rate;
+  accel = block->acceleration_steps_per_s2;
+  #if ENABLED(S_CURVE_ACCELERATION)
+    v1 = block->cruise_rate;
+    t_acc = double(block->acceleration_time) / (STEPPER_TIMER_RATE);
+    t_dec = double(block->deceleration_time) / (STEPPER_TIMER_RATE);
+    t_accel_end = ramp_time(accelerate_until, v0, v1, t_acc);
+  #else
+    v1 = accel > 0 ? sqrt(v0 * v0 + 2 * accel * accelerate_until) : v0;
+    t_acc = t_dec = 0;
+    t_accel_end = accel > 0 ? (v1 - v0) / accel : accelerate_until / v0;
+  #endif
+  t_cruise_end = t_accel_end + (decelerate_after - accelerate_until) / v1;
+}
+
+double StepAnalyzer::Profile::time(const double n) const {
+  if (n <= accelerate_until) {
+    #if ENABLED(S_CURVE_ACCELERATION)
+      return ramp_time(n, v0, v1, t_acc);
+    #else
+      return accel > 0 ? (sqrt(v0 * v0 + 2 * accel * n) - v0) / accel : n / v0;
+    #endif
+  }
+  if (n <= decelerate_after) return t_accel_end + (n - accelerate_until) / v1;
+
+  const double d = n - decelerate_after;
+  #if ENABLED(S_CURVE_ACCELERATION)
+    return t_cruise_end + ramp_time(d, v1, vf, t_dec);
+  #else
+    if (accel <= 0) return t_cruise_end + d / v1;
+    // Decelerate to final_rate, then hold it
+    const double ramp = (v1 * v1 - vf * vf) / (2 * accel);
+    if (d >= ramp) return t_cruise_end + (v1 - vf) / accel + (d - ramp) / vf;
+    return t_cruise_end + (v1 - sqrt(v1 * v1 - 2 * accel * d)) / accel;
+  #endif
+}
+
+// Called from the step pin's rising edge, in stepper ISR context
+void StepAnalyzer::step(const uint8_t index, const uint64_t timestamp, const bool forward) {
+  #if ENABLED(INPUT_SHAPING)
+    if (index < COUNT(shaper) && stepper.get_shaping(AxisEnum(index)).frequency > 0) {
+      static const bool invert_dir[] = { INVERT_X_DIR, INVERT_Y_DIR };
+      Shaper &s = shaper[index];
+      s.replay(timestamp);
+      s.actual.push_back({ timestamp, int8_t(forward != invert_dir[index] ? 1 : -1) });
+      s.match();
+      return;
+    }
+  #else
+    UNUSED(forward);
+  #endif
+  planned_step(index, timestamp);
+}
+
+// A step of a shaped motor, as the stepper commanded it to the shaper
+void StepAnalyzer::commanded(const uint8_t index, const uint64_t timestamp, const bool forward) {
+  planned_step(index, timestamp);
+  if (index >= COUNT(shaper)) return;
+  Shaper &s = shaper[index];
+  // M593 waits for the shaped steps to finish
+  if (s.idle()) s.configure(index);
+  s.command(timestamp, forward ? 1 : -1);
+}
+
+// The stepper stopped a shaped motor short, e.g. on an endstop
+void StepAnalyzer::shaping_stop(const uint8_t index) {
+  if (index < COUNT(shaper)) shaper[index].stop();
+}
+
+void StepAnalyzer::planned_step(const uint8_t index, const uint64_t timestamp) {
+  // The busy block stays at the tail until its last step has been taken
+  const block_t *block = &planner.block_buffer[planner.block_buffer_tail];
+  if (block != current) {
+    current = block;
+    profile.load(block);
+    blocks++;
+    LOOP_L_N(i, motors) motor[i].block_steps = 0;
+  }
+
+  Motor &m = motor[index];
+  m.steps++;
+  const uint32_t k = ++m.block_steps;
+  if (k > profile.steps[index]) return; // not a planned step (e.g., babystepping)
+
+  // Bresenham: the k-th motor step falls on event ceil((2k - 1) * events / (2 * steps))
+  const double n = ceil((2.0 * k - 1) * profile.step_event_count / (2.0 * profile.steps[index])),
+               expected = profile.time(n) * 1e9;
+
+  if (k > 1) {
+    const double jitter = double(timestamp - m.last_time) - (expected - m.last_expected);
+    const double magnitude = fabs(jitter);
+    uint8_t bin = 0;
+    while (bin < bins && magnitude >= bin_edges[bin]) bin++;
+    (jitter < 0 ? m.early : m.late)[bin]++;
+    m.sum_sq += jitter * jitter;
+    m.intervals++;
+    if (jitter > deadline_ns) m.missed++;
+
+    const int64_t drift = int64_t(timestamp - m.first_time) - int64_t(expected - m.first_expected);
+    NOLESS(m.max_late, drift);
+    NOMORE(m.max_early, drift);
+  }
+  else {
+    m.first_time = timestamp;
+    m.first_expected = expected;
+  }
+  m.last_time = timestamp;
+  m.last_expected = expected;
+}
+
+void StepAnalyzer::Shaper::configure(const uint8_t axis) {
+  impulses = 0;
+  commands.clear();
+  LOOP_L_N(i, COUNT(echo)) echo[i] = 0;
+  error = 0;
+
+  #if ENABLED(INPUT_SHAPING)
+    const shaping_settings_t &settings = stepper.get_shaping(AxisEnum(axis));
+    type = settings.type;
+    frequency = settings.frequency;
+    zeta = settings.zeta;
+    if (frequency <= 0) return;
+
+    // Amplitudes and times of the impulses, in periods of the damped ringing
+    const double root = sqrt(1 - zeta * zeta), period = 1 / (frequency * root),
+                 K = exp(-zeta * M_PI / root);
+    double a[3] = { 1 }, t[3] = { 0 };
+    switch (type) {
+      case SHAPER_ZVD: impulses = 3; a[1] = 2 * K; a[2] = K * K; t[1] = 0.5; t[2] = 1; break;
+      case SHAPER_MZV: {
+        const double K = exp(-0.75 * zeta * M_PI / root);
+        impulses = 3; a[0] = 1 - M_SQRT1_2; a[1] = (M_SQRT2 - 1) * K; a[2] = a[0] * K * K; t[1] = 0.375; t[2] = 0.75;
+      } break;
+      case SHAPER_EI: impulses = 3; a[0] = 0.25 * 1.05; a[1] = 0.5 * 0.95 * K; a[2] = a[0] * K * K; t[1] = 0.5; t[2] = 1; break;
+      default: impulses = 2; a[1] = K; t[1] = 0.5; break;
+    }
+    double sum = 0;
+    LOOP_L_N(i, impulses) sum += a[i];
+    LOOP_L_N(i, impulses) {
+      amplitude[i] = a[i] / sum;
+      delay[i] = llround(t[i] * period * 1e9);
+    }
+  #else
+    UNUSED(axis);
+  #endif
+}
+
+void StepAnalyzer::Shaper::replay(const uint64_t until) {
+  for (;;) {
+    uint64_t next = UINT64_MAX;
+    for (uint8_t i = 1; i < impulses; i++)
+      if (echo[i] < commands.size()) NOMORE(next, commands[echo[i]].time + delay[i]);
+    if (next == UINT64_MAX || next > until) break;
+
+    // All the impulses of one instant, then the steps to follow them
+    for (uint8_t i = 1; i < impulses; i++)
+      for (; echo[i] < commands.size() && commands[echo[i]].time + delay[i] == next; echo[i]++)
+        error += commands[echo[i]].dir * amplitude[i];
+    for (; error > 0.5; error -= 1) expected.push_back({ next, 1 });
+    for (; error < -0.5; error += 1) expected.push_back({ next, -1 });
+  }
+  // Let go of the commands every impulse is done with
+  while (impulses && echo[impulses - 1]) {
+    commands.pop_front();
+    LOOP_L_N(i, impulses) if (echo[i]) echo[i]--;
+  }
+}
+
+void StepAnalyzer::Shaper::command(const uint64_t timestamp, const int8_t dir) {
+  // The stepper adds a new step ahead of the impulses due at the same tick
+  replay(timestamp - 1);
+  commands.push_back({ timestamp, dir });
+  error += dir * amplitude[0];
+  replay(timestamp);
+  for (; error > 0.5; error -= 1) expected.push_back({ timestamp, 1 });
+  for (; error < -0.5; error += 1) expected.push_back({ timestamp, -1 });
+  match();
+}
+
+void StepAnalyzer::Shaper::match() {
+  for (; !expected.empty() && !actual.empty(); expected.pop_front(), actual.pop_front()) {
+    const Step &e = expected.front(), &a = actual.front();
+    steps++;
+    if (a.dir != e.dir) wrong_direction++;
+    const int64_t late = int64_t(a.time - e.time);
+    NOLESS(max_late, late);
+    NOMORE(max_early, late);
+    sum_sq += double(late) * late;
+  }
+}
+
+void StepAnalyzer::Shaper::stop() {
+  // Impulses not replayed yet are dropped, and so is the part of a step
+  // the motor hasn't taken
+  match();
+  unmatched += expected.size() + actual.size();
+  expected.clear();
+  actual.clear();
+  commands.clear();
+  LOOP_L_N(i, COUNT(echo)) echo[i] = 0;
+  error = 0;
+}
+
+void StepAnalyzer::report(FILE *out) {
+  static const char * const names[motors] = { "A", "B", "C", "E0" };
+  auto print_bins = [out](const uint64_t *count) {
+    LOOP_LE_N(i, bins) fprintf(out, "%s%llu", i ? ", " : "", (unsigned long long)count[i]);
+  };
+
+  fprintf(out, "{\n  \"blocks\": %llu,\n  \"deadline_ns\": %llu,\n  \"bin_edges_ns\": [", (unsigned long long)blocks, (unsigned long long)deadline_ns);
+  LOOP_L_N(i, bins) fprintf(out, "%s%u", i ? ", " : "", bin_edges[i]);
+  fprintf(out, "],\n  \"motors\": {");
+  LOOP_L_N(i, motors) {
+    const Motor &m = motor[i];
+    fprintf(out, "%s\n    \"%s\": {\n", i ? "," : "", names[i]);
+    fprintf(out, "      \"steps\": %llu,\n", (unsigned long long)m.steps);
+    fprintf(out, "      \"intervals\": %llu,\n", (unsigned long long)m.intervals);
+    fprintf(out, "      \"rms_jitter_ns\": %.1f,\n", m.intervals ? sqrt(m.sum_sq / m.intervals) : 0.0);
+    fprintf(out, "      \"max_early_ns\": %lld,\n", (long long)-m.max_early);
+    fprintf(out, "      \"max_late_ns\": %lld,\n", (long long)m.max_late);
+    fprintf(out, "      \"missed_deadlines\": %llu,\n", (unsigned long long)m.missed);
+    fprintf(out, "      \"early\": ["); print_bins(m.early); fprintf(out, "],\n");
+    fprintf(out, "      \"late\": ["); print_bins(m.late); fprintf(out, "]\n    }");
+  }
+  fprintf(out, "\n  }");
+
+  #if ENABLED(INPUT_SHAPING)
+    static const char * const types[] = { "ZV", "ZVD", "MZV", "EI" };
+    fprintf(out, ",\n  \"shaping\": {");
+    LOOP_L_N(i, COUNT(shaper)) {
+      Shaper &s = shaper[i];
+      // Every commanded step has been replayed by now
+      s.replay(UINT64_MAX);
+      s.match();
+      fprintf(out, "%s\n    \"%s\": {\n", i ? "," : "", names[i]);
+      fprintf(out, "      \"type\": \"%s\",\n", types[s.type < COUNT(types) ? s.type : 0]);
+      fprintf(out, "      \"frequency\": %.2f,\n", s.frequency);
+      fprintf(out, "      \"zeta\": %.3f,\n", s.zeta);
+      fprintf(out, "      \"steps\": %llu,\n", (unsigned long long)s.steps);
+      fprintf(out, "      \"unmatched_steps\": %llu,\n", (unsigned long long)(s.unmatched + s.expected.size() + s.actual.size()));
+      fprintf(out, "      \"wrong_direction\": %llu,\n", (unsigned long long)s.wrong_direction);
+      fprintf(out, "      \"rms_error_ns\": %.1f,\n", s.steps ? sqrt(s.sum_sq / s.steps) : 0.0);
+      fprintf(out, "      \"max_early_ns\": %lld,\n", (long long)-s.max_early);
+      fprintf(out, "      \"max_late_ns\": %lld\n    }", (long long)s.max_late);
+    }
+    fprintf(out, "\n  }");
+  #endif
+
+  fprintf(out, "\n}\n");
+}
+
+#endif // __PLAT_LINUX__
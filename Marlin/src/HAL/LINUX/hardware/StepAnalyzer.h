@@ -0,0 +1,119 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <deque>
+#include <stdint.h>
+#include <stdio.h>
+
+struct block_t;
+
+/**
+ * Step timing fidelity analyzer
+ *
+ * Fed with the rising step edges of every axis, it compares when each
+ * step actually happened with when the planner's profile for the busy
+ * block_t says it should have: the trapezoid, or the Bezier speed curve
+ * with S_CURVE_ACCELERATION. The expected step index of each motor
+ * follows the stepper's Bresenham distribution over step_event_count.
+ *
+ * Per motor it keeps a histogram of step-interval deviations (jitter),
+ * the worst early and late drift of a step from the profile within a
+ * block, and counts steps that came more than deadline_ns later than
+ * the planned interval after the previous one (missed deadlines).
+ *
+ * With INPUT_SHAPING the profile is checked against the commanded steps
+ * of X and Y, ahead of the shaper. Their motor steps are checked against
+ * the commanded steps convolved with the shaper's impulses, which the
+ * analyzer works out again from the shaper's definition.
+ */
+class StepAnalyzer {
+public:
+  static constexpr uint8_t motors = 4; // A, B, C, E0
+  static constexpr uint8_t bins = 10;
+  static const uint32_t bin_edges[bins];
+
+  StepAnalyzer(uint64_t deadline_ns = 20000);
+
+  void step(uint8_t motor, uint64_t timestamp, bool forward); // forward = DIR pin level
+  void commanded(uint8_t motor, uint64_t timestamp, bool forward);
+  void shaping_stop(uint8_t motor);
+  void report(FILE *out); // JSON
+
+private:
+  struct Profile {
+    uint32_t step_event_count, accelerate_until, decelerate_after;
+    uint32_t steps[motors];
+    double v0, v1, vf, accel; // steps/s, steps/s²
+    double t_acc, t_dec;      // s, S-curve ramp durations
+    double t_accel_end, t_cruise_end;
+
+    void load(const block_t *block);
+    double time(double n) const; // seconds to the n-th step event
+  };
+
+  struct Motor {
+    uint64_t steps = 0, intervals = 0, missed = 0;
+    int64_t max_early = 0, max_late = 0;
+    double sum_sq = 0;
+    uint64_t early[bins + 1] = {}, late[bins + 1] = {};
+
+    // Busy block
+    uint32_t block_steps = 0;
+    uint64_t first_time = 0, last_time = 0;
+    double first_expected = 0, last_expected = 0;
+  };
+
+  // The motor steps an input shaper should make, matched in order with
+  // the ones it made
+  struct Shaper {
+    struct Step { uint64_t time; int8_t dir; };
+    uint8_t impulses = 0;
+    double amplitude[3] = {}, frequency = 0, zeta = 0;
+    uint64_t delay[3] = {}; // ns
+    uint8_t type = 0;
+
+    std::deque<Step> commands, expected, actual;
+    size_t echo[3] = {};    // next command each impulse replays
+    double error = 0;       // replayed minus stepped position
+
+    uint64_t steps = 0, unmatched = 0, wrong_direction = 0;
+    int64_t max_early = 0, max_late = 0;
+    double sum_sq = 0;
+
+    bool idle() const { return !impulses || echo[impulses - 1] == commands.size(); }
+    void configure(uint8_t axis);
+    void replay(uint64_t until); // impulses up to and including 'until'
+    void command(uint64_t timestamp, int8_t dir);
+    void match();
+    void stop();
+  };
+
+  void planned_step(uint8_t motor, uint64_t timestamp);
+
+  uint64_t deadline_ns;
+  uint64_t blocks = 0;
+  Shaper shaper[2]; // A, B
+  const block_t *current = nullptr;
+  Profile profile;
+  Motor motor[motors];
+};
@@ -38,7 +38,10 @@ Timer::Timer() {
 }
 
 Timer::~Timer() {
-  timer_delete(timerid);
+  if (Clock::virtualTime())
+    Scheduler::detach(this);
+  else
+    timer_delete(timerid);
 }
 
 void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
@@ -48,6 +51,13 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
   frequency = sim_freq;
   cbfn = fn;
 
+  if (Clock::virtualTime()) {
+    // Driven by the Scheduler from the main thread instead of a POSIX signal
+    active = false;
+    Scheduler::attach(this);
+    return;
+  }
+
   sa.sa_flags = SA_SIGINFO;
   sa.sa_sigaction = Timer::handler;
   sigemptyset(&sa.sa_mask);
@@ -69,11 +79,13 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
 }
 
 void Timer::start(uint32_t frequency) {
+  if (Clock::virtualTime()) start_time = Clock::nanos();
   setCompare(this->frequency / frequency);
   //printf("timer(%ld) started\n", getID());
 }
 
 void Timer::enable() {
+  if (Clock::virtualTime()) { active = true; return; }
   if (sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -82,6 +94,7 @@ void Timer::enable() {
 }
 
 void Timer::disable() {
+  if (Clock::virtualTime()) { active = false; return; }
   if (sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -89,6 +102,14 @@ void Timer::disable() {
 }
 
 void Timer::setCompare(uint32_t compare) {
+  if (Clock::virtualTime()) {
+    // Like the MCU timers, the compare value counts from the last match
+    this->compare = compare;
+    this->period = Clock::ticksToNanos(compare ? compare : 1, frequency);
+    deadline = start_time + period;
+    return;
+  }
+
   uint32_t nsec_offset = 0;
   if (active) {
     nsec_offset = Clock::nanos() - this->start_time; // calculate how long the timer would have been running for
@@ -112,7 +133,24 @@ void Timer::setCompare(uint32_t compare) {
 }
 
 uint32_t Timer::getCount() {
+  if (Clock::virtualTime()) {
+    // Reading the counter costs a tick, so busy-waits on it (pulse width timing) make progress
+    Scheduler::advance(Clock::ticksToNanos(1, frequency));
+  }
   return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
 }
 
+void Timer::blockSignals() {
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGRTMIN);
+  pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+}
+
+void Timer::fire() {
+  start_time = deadline; // compare match resets the counter
+  deadline = start_time + period;
+  if (active) cbfn();
+}
+
 #endif // __PLAT_LINUX__
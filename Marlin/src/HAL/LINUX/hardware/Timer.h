@@ -30,7 +30,7 @@
 
 #include "Clock.h"
 
-class Timer {
+class Timer: public ScheduledEvent {
 public:
   Timer();
   virtual ~Timer();
@@ -48,6 +48,12 @@ public:
   uint32_t getOverruns() {return overruns;}
   uint32_t getAvgError() {return avg_error;}
 
+  // Virtual time: compare match on the event queue
+  void fire();
+
+  // Keep the timer "ISRs" off a helper thread, they belong to the firmware thread
+  static void blockSignals();
+
   intptr_t getID() {
     return (*(intptr_t*)timerid);
   }
@@ -28,6 +28,10 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <atomic>
+#include <functional>
 
 /**
  * Generic RingBuffer
@@ -74,6 +78,39 @@ private:
   volatile uint32_t index_read;
 };
 
+/**
+ * Wakes a thread blocked on a RingBuffer condition.
+ * Built on an eventfd so the timer "ISRs" (signal handlers) may notify.
+ * The waiter announces itself before re-checking its condition, so a
+ * producer only pays for a syscall when someone is actually asleep.
+ */
+class SerialEvent {
+public:
+  SerialEvent() { fd = eventfd(0, EFD_CLOEXEC); }
+  ~SerialEvent() { close(fd); }
+
+  // Sleep until ready() holds. Wakeups may be spurious, ready() is re-checked.
+  template <typename F> void wait(F ready) {
+    while (!ready()) {
+      waiting.store(true);
+      if (ready()) { waiting.store(false); break; }
+      uint64_t count;
+      if (::read(fd, &count, sizeof(count)) < 0) { /* EINTR, check again */ }
+    }
+  }
+
+  void notify() {
+    if (waiting.exchange(false)) {
+      const uint64_t one = 1;
+      if (::write(fd, &one, sizeof(one)) < 0) { /* counter saturated, waiter is awake anyway */ }
+    }
+  }
+
+private:
+  int fd;
+  std::atomic<bool> waiting { false };
+};
+
 class HalSerial {
 public:
 
@@ -92,21 +129,28 @@ public:
     return receive_buffer.peek(&value) ? value : -1;
   }
 
-  int read() { return receive_buffer.read(); }
+  int read() {
+    const int c = receive_buffer.read();
+    rx_space.notify();
+    return c;
+  }
 
   size_t write(char c) {
     if (!host_connected) return 0;
-    while (!transmit_buffer.free());
-    return transmit_buffer.write(c);
+    tx_space.wait([this]{ return !transmit_buffer.full(); });
+    const size_t ret = transmit_buffer.write(c);
+    tx_data.notify();
+    return ret;
   }
 
   operator bool() { return host_connected; }
 
   uint16_t available() {
+    if (underflow && receive_buffer.empty()) underflow();
     return (uint16_t)receive_buffer.available();
   }
 
-  void flush() { receive_buffer.clear(); }
+  void flush() { receive_buffer.clear(); rx_space.notify(); }
 
   uint8_t availableForWrite() {
     return transmit_buffer.free() > 255 ? 255 : (uint8_t)transmit_buffer.free();
@@ -114,7 +158,7 @@ public:
 
   void flushTX() {
     if (host_connected)
-      while (transmit_buffer.available()) { /* nada */ }
+      tx_space.wait([this]{ return transmit_buffer.empty(); });
   }
 
   void printf(const char *format, ...) {
@@ -123,15 +167,8 @@ public:
     va_start(vArgs, format);
     int length = vsnprintf((char *) buffer, 256, (char const *) format, vArgs);
     va_end(vArgs);
-    if (length > 0 && length < 256) {
-      if (host_connected) {
-        for (int i = 0; i < length;) {
-          if (transmit_buffer.write(buffer[i])) {
-            ++i;
-          }
-        }
-      }
-    }
+    if (length > 0 && length < 256)
+      for (int i = 0; i < length; i++) write(buffer[i]);
   }
 
   #define DEC 10
@@ -202,7 +239,15 @@ public:
   void println(double value, int round = 6) { printf("%f\n" , value); }
   void println() { print('\n'); }
 
-  volatile RingBuffer<uint8_t, 128> receive_buffer;
-  volatile RingBuffer<uint8_t, 128> transmit_buffer;
+  // Called when the firmware polls an empty receive buffer. Virtual time uses
+  // this to read host input in lock-step with the firmware.
+  std::function<void()> underflow;
+
+  // Large enough for a host streaming ahead of the "ok"s
+  volatile RingBuffer<uint8_t, 4096> receive_buffer;
+  volatile RingBuffer<uint8_t, 4096> transmit_buffer;
   volatile bool host_connected;
+
+  // Host side I/O threads sleep on these instead of polling the buffers
+  SerialEvent rx_space, tx_data, tx_space;
 };
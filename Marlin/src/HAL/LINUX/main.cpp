@@ -24,60 +24,79 @@ extern void setup();
 extern void loop();
 
 #include <thread>
+#include <getopt.h>
+#include <signal.h>
 
 #include <iostream>
 #include <fstream>
+#include <random>
 
 #include "../../inc/MarlinConfig.h"
 #include <stdio.h>
 #include <stdarg.h>
 #include "../shared/Delay.h"
-#include "hardware/IOLoggerCSV.h"
+#include "../../gcode/parser.h"
+#include "../../gcode/queue.h"
+#include "../../module/planner.h"
+#include "../../module/stepper.h"
+#include "hardware/IOLoggerBinary.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
+#include "hardware/StepAnalyzer.h"
+#include "hardware/Scheduler.h"
+#include "hardware/HostPort.h"
+#include "hardware/Timer.h"
 
-// simple stdout / stdin implementation for fake serial port
-void write_serial_thread() {
-  for (;;) {
-    for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
-      fputc(usb_serial.transmit_buffer.read(), stdout);
-    }
-    std::this_thread::yield();
-  }
-}
+//#define GPIO_LOGGING // Full GPIO and Positional Logging
 
-void read_serial_thread() {
-  char buffer[255] = {};
-  for (;;) {
-    std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
-    if (fgets(buffer, len, stdin))
-      for (std::size_t i = 0; i < strlen(buffer); i++)
-        usb_serial.receive_buffer.write(buffer[i]);
-    std::this_thread::yield();
-  }
-}
+#if HAS_FAN0
+  #define PART_FAN_PIN FAN_PIN
+#else
+  #define PART_FAN_PIN P_NC
+#endif
 
-void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
-  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
-  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
-  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
-  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
-
-  //#define GPIO_LOGGING // Full GPIO and Positional Logging
-
-  #ifdef GPIO_LOGGING
-    IOLoggerCSV logger("all_gpio_log.csv");
-    Gpio::attachLogger(&logger);
-
-    std::ofstream position_log;
-    position_log.open("axis_position_log.csv");
+class Simulation {
+public:
+  Simulation(const ThermalModel &hotend_model, const ThermalModel &bed_model, StepAnalyzer *analyzer = nullptr) :
+    hotend(HEATER_0_PIN, TEMP_0_PIN, PART_FAN_PIN, hotend_model),
+    bed(HEATER_BED_PIN, TEMP_BED_PIN, P_NC, bed_model),
+    x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN),
+    y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN),
+    z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN),
+    extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC)
+    #ifdef GPIO_LOGGING
+      , logger("all_gpio_log.bin")
+    #endif
+  {
+    if (analyzer) {
+      x_axis.attachAnalyzer(analyzer, A_AXIS);
+      y_axis.attachAnalyzer(analyzer, B_AXIS);
+      z_axis.attachAnalyzer(analyzer, C_AXIS);
+      extruder0.attachAnalyzer(analyzer, E_AXIS);
+    }
+    #ifdef GPIO_LOGGING
+      Gpio::attachLogger(&logger);
+      position_log.open("axis_position_log.csv");
+    #endif
+  }
 
-    int32_t x,y,z;
-  #endif
+  void update() {
+    // Deliver the pin events queued since the last update
+    hotend.dispatch();
+    bed.dispatch();
+    x_axis.dispatch();
+    y_axis.dispatch();
+    z_axis.dispatch();
+    extruder0.dispatch();
 
-  for (;;) {
+    // Filament pushed through the nozzle carries heat away
+    const int32_t e = extruder0.position;
+    if (e > last_e) {
+      hotend.extrude((e - last_e) * filament_area / planner.settings.axis_steps_per_mm[E_AXIS_N(0)]);
+      last_e = e;
+    }
+    else
+      NOMORE(last_e, e);
 
     hotend.update();
     bed.update();
@@ -89,24 +108,228 @@ void simulation_loop() {
 
     #ifdef GPIO_LOGGING
       if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
-        uint64_t update = MAX3(x_axis.last_update, y_axis.last_update, z_axis.last_update);
-        position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << std::endl;
-        position_log.flush();
+        uint64_t update = _MAX(x_axis.last_update, y_axis.last_update, z_axis.last_update);
+        position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << '\n';
         x = x_axis.position;
         y = y_axis.position;
         z = z_axis.position;
       }
-      // flush the logger
+      // drain the trace ring into the file
       logger.flush();
     #endif
+  }
+
+  Heater hotend, bed;
+  LinearAxis x_axis, y_axis, z_axis, extruder0;
+  int32_t last_e = extruder0.position;
+  const float filament_area = sq(DEFAULT_NOMINAL_FILAMENT_DIA) * float(M_PI) / 4;
+
+  #ifdef GPIO_LOGGING
+    IOLoggerBinary logger;
+    std::ofstream position_log;
+    int32_t x, y, z;
+  #endif
+};
+
+volatile sig_atomic_t simulation_running = 1;
+
+static void stop_running(int) { simulation_running = 0; }
+
+static Simulation *sim = nullptr;
+static StepAnalyzer *analyzer = nullptr;
+static const char *step_stats = nullptr, *bench_report = nullptr;
+static std::thread simulation;
+
+void simulation_loop() {
+  Timer::blockSignals();
+  while (simulation_running) {
+    sim->update();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+// The stepper's view of input-shaped axes, see HAL.h
+void HAL_commanded_step(const uint8_t axis, const bool forward) {
+  if (analyzer) analyzer->commanded(axis, Clock::nanos(), forward);
+}
 
-    std::this_thread::yield();
+void HAL_shaping_stop(const uint8_t axis) {
+  if (analyzer) analyzer->shaping_stop(axis);
+}
+
+static void write_report(const char *path, std::function<void(FILE*)> report) {
+  FILE *out = strcmp(path, "-") ? fopen(path, "w") : stderr;
+  if (!out) { fprintf(stderr, "Can't write '%s'\n", path); return; }
+  report(out);
+  if (out != stderr) fclose(out);
+}
+
+// Called once simulation_running drops or a benchmark is done, from the
+// main loop or from idle() while a command is waiting
+void simulation_exit() {
+  if (simulation.joinable()) simulation.join();
+  sim->update();
+
+  if (bench_report) write_report(bench_report, Benchmark::report);
+  if (analyzer) write_report(step_stats, [](FILE *out){ analyzer->report(out); });
+
+  // Host threads never return, leave without unwinding them
+  SERIAL_FLUSHTX();
+  exit(0);
+}
+
+// The float parser before GCodeParser::parse_float: strtof(), cut at any 'E'
+static float reference_float(const char *text) {
+  std::string s(text);
+  const std::size_t end = s.find_first_of(" Ee");
+  if (end != std::string::npos && s[end] != ' ') s.erase(end);
+  return strtof(s.c_str(), nullptr);
+}
+
+// Check that parse_float gives bit for bit what strtof() does, on hand picked
+// cases and then on random numbers shaped like slicer output
+static int fuzz_float(const unsigned long count) {
+  static const char * const cases[] = {
+    "0", "-0", "+0", "0.", ".0", "-.0", ".5", "-.5", "+", "-", ".", "", " 1", "1 ", "1.2.3", "1e5", "1E-3", "2.5E",
+    "0x1A", "0X.8p1", "inf", "-nan", "16777216", "16777217", "-16777215.9", "0.0000000001", "0.00000000001",
+    "1.50000000000000000000", "000000000000000000000012.5", "99999999", "3.4028235e38", "123.456Y7", "10*42"
+  };
+  static const char * const tails[] = { "", "", "", " ", " Y10", "Y2.5", "E0.1", "e3", "*71" };
+  std::mt19937 rng(12345);
+  auto pick = [&](const int n) { return int(rng() % n); };
+
+  unsigned long mismatches = 0;
+  std::chrono::steady_clock::duration parse_time{}, strtof_time{};
+  for (unsigned long i = 0; i < count; i++) {
+    char text[40], work[40];
+    if (i < COUNT(cases))
+      strcpy(text, cases[i]);
+    else {
+      char *t = text;
+      switch (pick(4)) { case 0: *t++ = '-'; break; case 1: if (!pick(4)) *t++ = '+'; }
+      for (int n = pick(6); n--;) *t++ = '0' + pick(10);    // Integer digits, some with leading zeros
+      if (pick(4)) {
+        *t++ = '.';
+        for (int n = pick(pick(4) ? 6 : 12); n--;) *t++ = '0' + pick(10);
+      }
+      strcpy(t, tails[pick(COUNT(tails))]);
+    }
+
+    strcpy(work, text);
+    auto start = std::chrono::steady_clock::now();
+    const float got = GCodeParser::parse_float(work);
+    parse_time += std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    volatile float plain = strtof(text, nullptr);
+    strtof_time += std::chrono::steady_clock::now() - start;
+    UNUSED(plain);
+
+    const float want = reference_float(text);
+    if (memcmp(&got, &want, sizeof(float)) || strcmp(work, text)) {
+      if (mismatches < 10) fprintf(stderr, "'%s': parse_float %.9g, strtof %.9g\n", text, double(got), double(want));
+      mismatches++;
+    }
   }
+
+  const double ns = 1e9 * std::chrono::duration<double>(parse_time).count() / count,
+               strtof_ns = 1e9 * std::chrono::duration<double>(strtof_time).count() / count;
+  fprintf(stderr, "%lu numbers, %lu mismatches, %.1f ns per number (strtof %.1f ns)\n", count, mismatches, ns, strtof_ns);
+  return mismatches ? 1 : 0;
 }
 
-int main() {
-  std::thread write_serial (write_serial_thread);
-  std::thread read_serial (read_serial_thread);
+static void usage(const char *name) {
+  fprintf(stderr,
+    "Usage: %s [options]\n"
+    "  -t, --virtual-time   Deterministic discrete-event time instead of the wall clock\n"
+    "  -s, --serial SPEC    Host endpoint of the next serial port (default: stdio, then pty)\n"
+    "                       SPEC is stdio, pty[:LINK] or unix:PATH\n"
+    "  -H, --hotend MODEL   Thermal model of the hotend and bed as key=value[,key=value...]\n"
+    "  -B, --bed MODEL      Keys: power capacity loss fan_loss filament ambient r25 beta\n"
+    "                       pullup noise (W, J/K, W/K, W/K, J/(K mm3), C, Ohm, K, Ohm, ADC counts)\n"
+    "  -b, --bench FILE     Run the G-code from serial 0 under virtual time, then exit and\n"
+    "                       report firmware-side throughput as JSON to FILE (- for stderr)\n"
+    "  -S, --step-stats FILE  Compare step timing with the planned profiles, report\n"
+    "                       as JSON to FILE (- for stderr) on SIGINT or SIGTERM\n"
+    "  -F, --fuzz-float COUNT  Check the G-code float parser against strtof() on COUNT\n"
+    "                       numbers, then exit\n"
+    "  -h, --help           Show this help\n", name
+  );
+}
+
+int main(int argc, char *argv[]) {
+  bool virtual_time = false;
+  std::string serial_spec[NUM_SERIAL] = {
+    "stdio"
+    #if NUM_SERIAL > 1
+      , "pty"
+    #endif
+  };
+  uint8_t serial_specs = 0;
+  ThermalModel hotend_model, bed_model = ThermalModel::bed();
+
+  static const struct option long_options[] = {
+    { "virtual-time", no_argument,       nullptr, 't' },
+    { "serial",       required_argument, nullptr, 's' },
+    { "hotend",       required_argument, nullptr, 'H' },
+    { "bed",          required_argument, nullptr, 'B' },
+    { "bench",        required_argument, nullptr, 'b' },
+    { "step-stats",   required_argument, nullptr, 'S' },
+    { "fuzz-float",   required_argument, nullptr, 'F' },
+    { "help",         no_argument,       nullptr, 'h' },
+    { nullptr, 0, nullptr, 0 }
+  };
+  for (int opt; (opt = getopt_long(argc, argv, "ts:H:B:b:S:F:h", long_options, nullptr)) != -1;) {
+    switch (opt) {
+      case 't': virtual_time = true; break;
+      case 's':
+        if (serial_specs == NUM_SERIAL) { fprintf(stderr, "Only %d serial port(s) configured\n", NUM_SERIAL); return 1; }
+        serial_spec[serial_specs++] = optarg;
+        break;
+      case 'H':
+      case 'B':
+        if (!(opt == 'H' ? hotend_model : bed_model).parse(optarg)) { fprintf(stderr, "Bad thermal model '%s'\n", optarg); return 1; }
+        break;
+      case 'b': bench_report = optarg; virtual_time = true; break;
+      case 'S': step_stats = optarg; break;
+      case 'F': return fuzz_float(strtoul(optarg, nullptr, 10));
+      default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+    }
+  }
+
+  Clock::setVirtualTime(virtual_time);
+
+  // Only the main thread takes SIGINT / SIGTERM, helper threads inherit the block.
+  // No SA_RESTART, so a lock-step read waiting for the host is interrupted too.
+  sigset_t stop_signals;
+  sigemptyset(&stop_signals);
+  sigaddset(&stop_signals, SIGINT);
+  sigaddset(&stop_signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+  struct sigaction sa = {};
+  sa.sa_handler = stop_running;
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+
+  HalSerial* const serial_port[NUM_SERIAL] = {
+    &MYSERIAL0
+    #if NUM_SERIAL > 1
+      , &MYSERIAL1
+    #endif
+  };
+  HostPort* host_port[NUM_SERIAL];
+  for (uint8_t i = 0; i < NUM_SERIAL; i++) {
+    host_port[i] = new HostPort(*serial_port[i]);
+    if (!host_port[i]->open(serial_spec[i])) {
+      fprintf(stderr, "Serial %d: can't open '%s'\n", i, serial_spec[i].c_str());
+      return 1;
+    }
+    // Lock-step input keeps virtual time deterministic, extra ports stay asynchronous
+    if (virtual_time && i == 0)
+      host_port[i]->start([]{ return simulation_running && !queue.has_commands_queued(); });
+    else
+      host_port[i]->start();
+    fprintf(stderr, "Serial %d: %s\n", i, host_port[i]->name().c_str());
+  }
 
   #if NUM_SERIAL > 0
     MYSERIAL0.begin(BAUDRATE);
@@ -119,19 +342,38 @@ int main() {
 
   HAL_timer_init();
 
-  std::thread simulation (simulation_loop);
+  if (step_stats) analyzer = new StepAnalyzer();
+  sim = new Simulation(hotend_model, bed_model, analyzer);
+  PeriodicEvent *sim_update = nullptr;
+  if (virtual_time) {
+    // Peripherals are sampled on the event queue, between timer interrupts
+    sim_update = new PeriodicEvent(100000, []{ sim->update(); });
+    sim_update->start(Clock::nanos());
+    Scheduler::attach(sim_update);
+  }
+  else
+    simulation = std::thread(simulation_loop);
+
+  pthread_sigmask(SIG_UNBLOCK, &stop_signals, nullptr);
 
   DELAY_US(10000);
 
   setup();
-  for (;;) {
+  if (bench_report) Benchmark::start();
+
+  while (simulation_running) {
     loop();
-    std::this_thread::yield();
+    if (bench_report && !planner.has_blocks_queued()
+      #if ENABLED(INPUT_SHAPING)
+        && !stepper.is_shaping()
+      #endif
+    ) {
+      Benchmark::samplePosition();
+      // A benchmark ends once its input is used up and all motion is done
+      if (host_port[0]->drained() && !queue.has_commands_queued()) break;
+    }
   }
-
-  simulation.join();
-  write_serial.join();
-  read_serial.join();
+  simulation_exit();
 }
 
 #endif // __PLAT_LINUX__
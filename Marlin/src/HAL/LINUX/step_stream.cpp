@@ -0,0 +1,76 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(STEP_STREAM)
+
+#include "../../module/stepper.h"
+
+#if ENABLED(STEPPER_ISR_PROFILE)
+  #include "../../feature/stepper_profile.h"
+#endif
+
+/**
+ * Step stream playback
+ *
+ * The step timer stands in for a DMA channel. It takes a batch of frames
+ * from the ring, plays them one compare match each, and only asks the
+ * stepper for more when the batch is done, the way the I2S out_eof
+ * interrupt wakes stepperTask() on ESP32. With nothing to play it polls
+ * at 1kHz, like the stepper ISR waiting for a block, and the first frame
+ * of the next block follows its delay from the poll that finds it.
+ */
+
+static uint16_t batch = 0; // Frames left to play in the batch
+
+HAL_STEP_TIMER_ISR() {
+  HAL_timer_isr_prologue(STEP_TIMER_NUM);
+
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    STEPPER_PROFILE(ISR);
+  #endif
+
+  // Play the frame that came due
+  if (batch) {
+    stepper.stream_output(step_stream.front());
+    step_stream.pop();
+    batch--;
+    HAL_BENCH_COUNT(stream_frames);
+  }
+
+  // Top up the ring and take the next batch
+  if (!batch) {
+    stepper.stream_fill();
+    batch = _MIN(step_stream.count(), uint16_t(STEP_STREAM_BATCH));
+    if (batch) HAL_BENCH_COUNT(stream_batches);
+  }
+
+  // Come back when the next frame is due
+  HAL_timer_set_compare(STEP_TIMER_NUM, batch ? step_stream.front().ticks : (STEPPER_TIMER_RATE) / 1000UL);
+
+  HAL_timer_isr_epilogue(STEP_TIMER_NUM);
+}
+
+#endif // STEP_STREAM
+#endif // __PLAT_LINUX__
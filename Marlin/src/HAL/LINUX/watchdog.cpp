@@ -29,7 +29,10 @@
 #include "watchdog.h"
 
 void watchdog_init() {}
-void HAL_watchdog_refresh() {}
+// A halted printer spins here waiting for a reset, it can still be stopped
+void HAL_watchdog_refresh() {
+  if (!simulation_running) simulation_exit();
+}
 
 #endif
 
@@ -19,22 +19,16 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
-#pragma once
+#include "../../inc/MarlinConfig.h"
 
-#include <mutex>
-#include <list>
-#include <fstream>
-#include "Gpio.h"
+#if ENABLED(STEP_STREAM)
 
-class IOLoggerCSV: public IOLogger {
-public:
-  IOLoggerCSV(std::string filename);
-  virtual ~IOLoggerCSV();
-  void flush();
-  void log(GpioEvent ev);
+  #include "step_stream.h"
 
-private:
-  std::ofstream file;
-  std::list<GpioEvent> events;
-  std::mutex vector_lock;
-};
+  StepStream step_stream;
+
+  step_frame_t StepStream::frame[STEP_STREAM_SIZE];
+  volatile uint16_t StepStream::head = 0, StepStream::tail = 0;
+  volatile hal_timer_t StepStream::made = 0, StepStream::played = 0;
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Step stream
+ *
+ * A ring of timed step frames from the stepper to the HAL. The stepper
+ * makes them ahead of time in Stepper::stream_fill(), and the HAL plays
+ * them back from its step timer ISR (or turns them into port bitmaps for
+ * DMA), calling stream_fill() again as the ring drains. A HAL supporting
+ * this defines HAL_STEP_STREAM and its own HAL_STEP_TIMER_ISR(), so
+ * DISABLE_STEPPER_DRIVER_INTERRUPT() still holds off the stepper code.
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+typedef struct {
+  hal_timer_t ticks;  // Step timer ticks after the previous frame
+  uint8_t step,       // Axes to step, by AxisEnum
+          dir,        // Stepper::last_direction_bits for these steps
+          extruder;   // The E stepper to step
+} step_frame_t;
+
+class StepStream {
+public:
+  static step_frame_t frame[STEP_STREAM_SIZE];
+  static volatile uint16_t head, tail;        // Written by the producer / the consumer only
+  static volatile hal_timer_t made, played;   // Ticks of all frames pushed / popped
+
+  FORCE_INLINE static uint16_t next(const uint16_t i) { return (i + 1) & (STEP_STREAM_SIZE - 1); }
+  FORCE_INLINE static uint16_t count() { return (head - tail) & (STEP_STREAM_SIZE - 1); }
+  FORCE_INLINE static bool empty() { return head == tail; }
+  FORCE_INLINE static bool full() { return next(head) == tail; }
+
+  // Step time in the ring, not played yet
+  FORCE_INLINE static hal_timer_t ahead() { return made - played; }
+
+  // Producer: fill in the free frame, then push it
+  FORCE_INLINE static step_frame_t& free_frame() { return frame[head]; }
+  FORCE_INLINE static void push() { made += frame[head].ticks; head = next(head); }
+
+  // Consumer: play the oldest frame, then pop it
+  FORCE_INLINE static const step_frame_t& front() { return frame[tail]; }
+  FORCE_INLINE static void pop() { played += frame[tail].ticks; tail = next(tail); }
+};
+
+extern StepStream step_stream;
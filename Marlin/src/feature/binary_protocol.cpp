@@ -22,15 +22,107 @@
 
 #include "../inc/MarlinConfigPre.h"
 
-#if ENABLED(BINARY_FILE_TRANSFER)
+#if HAS_BINARY_STREAM
 
-#include "../sd/cardreader.h"
 #include "binary_protocol.h"
 
+#if ENABLED(BINARY_FILE_TRANSFER)
+
 char* SDFileTransferProtocol::Packet::Open::data = nullptr;
 size_t SDFileTransferProtocol::data_waiting, SDFileTransferProtocol::transfer_timeout, SDFileTransferProtocol::idle_timeout;
 bool SDFileTransferProtocol::transfer_active, SDFileTransferProtocol::dummy_transfer, SDFileTransferProtocol::compression;
 
+#endif // BINARY_FILE_TRANSFER
+
+#if ENABLED(BINARY_MOTION)
+
+#include "../MarlinCore.h"
+#include "../gcode/gcode.h"
+#include "../module/motion.h"
+
+#if ENABLED(PRINTCOUNTER)
+  #include "../module/printcounter.h"
+#endif
+
+void MotionProtocol::process(uint8_t packet_type, char* buffer, const uint16_t length) {
+  switch (static_cast<Motion>(packet_type)) {
+    case Motion::QUERY:
+      SERIAL_ECHOLNPAIR("PMV:version:", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH);
+      break;
+    case Motion::MOVES:
+      if (!moves(buffer, length)) SERIAL_ECHOLNPGM("PMV:invalid");
+      break;
+    case Motion::COMMAND:
+      if (!length || buffer[length - 1] != '\0')
+        SERIAL_ECHOLNPGM("PMV:invalid");
+      else {
+        parser.parse(buffer);
+        gcode.process_parsed_command(true);   // The packet was already acknowledged
+      }
+      break;
+    default:
+      SERIAL_ECHOLNPGM("PMV:invalid");
+      break;
+  }
+}
+
+/**
+ * Plan the moves in a MOVES packet, as G1 would, without the parser.
+ * Return false if the packet ends in the middle of a move.
+ */
+bool MotionProtocol::moves(const char *buffer, const uint16_t length) {
+  const char * const end = buffer + length;
+  while (buffer < end) {
+    const uint8_t flags = *buffer++;
+    int32_t value[5];
+    LOOP_L_N(i, COUNT(value)) if (TEST(flags, i)) {
+      if (end - buffer < 4) return false;
+      memcpy(&value[i], buffer, 4);
+      buffer += 4;
+    }
+
+    if (!IsRunning()
+      #if ENABLED(NO_MOTION_BEFORE_HOMING)
+        || axis_unhomed_error(flags & (MOVE_X | MOVE_Y | MOVE_Z))
+      #endif
+    ) continue;
+
+    LOOP_XYZ(i) {
+      if (TEST(flags, i)) {
+        const float v = value[i] / 1000.0f;
+        destination[i] = gcode.axis_is_relative(AxisEnum(i)) ? current_position[i] + v : LOGICAL_TO_NATIVE(v, i);
+      }
+      else
+        destination[i] = current_position[i];
+    }
+
+    if (flags & MOVE_E) {
+      const float v = value[E_AXIS] / 100000.0f;
+      destination.e = gcode.axis_is_relative(E_AXIS) ? current_position.e + v : v;
+    }
+    else
+      destination.e = current_position.e;
+
+    if ((flags & MOVE_F) && value[4] > 0)
+      feedrate_mm_s = MMM_TO_MMS(value[4] / 1000.0f);
+
+    #if ENABLED(PRINTCOUNTER)
+      if (!DEBUGGING(DRYRUN))
+        print_job_timer.incFilamentUsed(destination.e - current_position.e);
+    #endif
+
+    prepare_line_to_destination();
+  }
+  return true;
+}
+
+#endif // BINARY_MOTION
+
+bool BinaryStream::active; // = false
+#if NUM_SERIAL > 1
+  int8_t BinaryStream::port;
+#endif
+
 BinaryStream binaryStream[NUM_SERIAL];
 
-#endif // BINARY_FILE_TRANSFER
+#endif // HAS_BINARY_STREAM
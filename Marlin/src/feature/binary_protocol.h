@@ -23,7 +23,10 @@
 
 #include "../inc/MarlinConfig.h"
 
-#define BINARY_STREAM_COMPRESSION
+#if ENABLED(BINARY_FILE_TRANSFER)
+  #include "../sd/cardreader.h"
+  #define BINARY_STREAM_COMPRESSION
+#endif
 
 #if ENABLED(BINARY_STREAM_COMPRESSION)
   #include "../libs/heatshrink/heatshrink_decoder.h"
@@ -54,6 +57,8 @@ inline int bs_read_serial(const uint8_t index) {
   static uint8_t decode_buffer[512] = {};
 #endif
 
+#if ENABLED(BINARY_FILE_TRANSFER)
+
 class SDFileTransferProtocol  {
 private:
   struct Packet {
@@ -218,9 +223,42 @@ public:
   static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0, TIMEOUT = 10000, IDLE_PERIOD = 1000;
 };
 
+#endif // BINARY_FILE_TRANSFER
+
+#if ENABLED(BINARY_MOTION)
+
+/**
+ * G-code moves sent as packed fixed-point values, for the planner
+ * without the text scanning and float parsing of each line.
+ *
+ * A MOVES packet holds moves back to back. Each is a byte of flags for
+ * the values that follow, then those values as 32-bit little-endian
+ * integers, in this order:
+ *   bit 0 X, bit 1 Y, bit 2 Z - in microns
+ *   bit 3 E                   - in 1/100000 mm
+ *   bit 4 F                   - in 1/1000 mm/min
+ * Moves are treated like G1 with the same words, following G90/G91,
+ * M82/M83 and the workspace offsets. A COMMAND packet holds one G-code
+ * line with its terminator, which runs before the next packet is read.
+ */
+class MotionProtocol {
+public:
+  static void process(uint8_t packet_type, char* buffer, const uint16_t length);
+
+  static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
+
+private:
+  enum class Motion : uint8_t { QUERY, MOVES, COMMAND };
+  enum MoveFlag : uint8_t { MOVE_X = _BV(0), MOVE_Y = _BV(1), MOVE_Z = _BV(2), MOVE_E = _BV(3), MOVE_F = _BV(4) };
+
+  static bool moves(const char *buffer, const uint16_t length);
+};
+
+#endif // BINARY_MOTION
+
 class BinaryStream {
 public:
-  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER };
+  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER, MOTION };
 
   enum class ProtocolControl : uint8_t { SYNC = 1, CLOSE };
 
@@ -291,8 +329,8 @@ public:
       stream_state = StreamState::PACKET_TIMEOUT;
       return false;
     }
-    if (!bs_serial_data_available(card.transfer_port_index)) return false;
-    data = bs_read_serial(card.transfer_port_index);
+    if (!bs_serial_data_available(port)) return false;
+    data = bs_read_serial(port);
     packet.timeout = millis() + PACKET_MAX_WAIT;
     return true;
   }
@@ -302,9 +340,10 @@ public:
     uint8_t data = 0;
     millis_t transfer_window = millis() + RX_TIMESLICE;
 
-    #if ENABLED(SDSUPPORT)
-      PORT_REDIRECT(card.transfer_port_index);
-    #endif
+    // A packet waiting on the planner calls idle(), which comes back here
+    if (dispatching) return;
+
+    PORT_REDIRECT(port);
 
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Warray-bounds"
@@ -417,8 +456,11 @@ public:
           bytes_received += packet.header.size;
 
           SERIAL_ECHOLNPAIR("ok", packet.header.sync); // transmit valid packet received
+          dispatching = true;
           dispatch();
+          dispatching = false;
           stream_state = StreamState::PACKET_RESET;
+          if (!active) return;                          // Back to ASCII, so leave the rest to the G-code queue
           break;
         case StreamState::PACKET_RESEND:
           if (packet_retries < MAX_RETRIES || MAX_RETRIES == 0) {
@@ -451,15 +493,22 @@ public:
       case Protocol::CONTROL:
         switch(static_cast<ProtocolControl>(packet.header.type())) {
           case ProtocolControl::CLOSE: // revert back to ASCII mode
-            card.flag.binary_mode = false;
+            active = false;
             break;
           default:
             SERIAL_ECHO_MSG("Unknown BinaryProtocolControl Packet");
         }
         break;
-      case Protocol::FILE_TRANSFER:
-        SDFileTransferProtocol::process(packet.header.type(), packet.buffer, packet.header.size); // send user data to be processed
-      break;
+      #if ENABLED(BINARY_FILE_TRANSFER)
+        case Protocol::FILE_TRANSFER:
+          SDFileTransferProtocol::process(packet.header.type(), packet.buffer, packet.header.size); // send user data to be processed
+        break;
+      #endif
+      #if ENABLED(BINARY_MOTION)
+        case Protocol::MOTION:
+          MotionProtocol::process(packet.header.type(), packet.buffer, packet.header.size);
+          break;
+      #endif
       default:
         SERIAL_ECHO_MSG("Unsupported Binary Protocol");
     }
@@ -467,11 +516,32 @@ public:
 
   void idle() {
     // Some Protocols may need periodic updates without new data
-    SDFileTransferProtocol::idle();
+    #if ENABLED(BINARY_FILE_TRANSFER)
+      SDFileTransferProtocol::idle();
+    #endif
+  }
+
+  // Switch a serial port to the binary protocol, for M28 B1
+  static void start(const int8_t p) {
+    SERIAL_ECHO_MSG("Switching to Binary Protocol");
+    active = true;
+    #if NUM_SERIAL > 1
+      port = p;
+    #else
+      UNUSED(p);
+    #endif
   }
 
+  static bool active;             // The port is in binary mode, until a CLOSE packet
+  #if NUM_SERIAL > 1
+    static int8_t port;           // The port in binary mode
+  #else
+    static constexpr int8_t port = 0;
+  #endif
+
   static const uint16_t PACKET_MAX_WAIT = 500, RX_TIMESLICE = 20, MAX_RETRIES = 0, VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
   uint8_t  packet_retries, sync;
+  bool dispatching;
   uint16_t buffer_next_index;
   uint32_t bytes_received;
   StreamState stream_state = StreamState::PACKET_RESET;
@@ -0,0 +1,120 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(STEPPER_ISR_PROFILE)
+
+#include "stepper_profile.h"
+#include "../module/stepper.h"
+
+StepperProfile stepper_profile;
+
+StepperProfile::phase_t StepperProfile::phase[PROFILE_PHASES];
+millis_t StepperProfile::since; // = 0
+
+void StepperProfile::init() {
+  #ifdef PROFILE_CYCLE_COUNTER
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    #if __CORTEX_M == 7
+      DWT->LAR = 0xC5ACCE55; // Unlock DWT on the M7
+    #endif
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  #endif
+  reset();
+}
+
+void StepperProfile::reset() {
+  const bool was_enabled = stepper.suspend();
+  LOOP_L_N(p, PROFILE_PHASES) {
+    phase[p] = {};
+    phase[p].min = UINT32_MAX;
+  }
+  since = millis();
+  if (was_enabled) stepper.wake_up();
+}
+
+uint32_t StepperProfile::percentile(const phase_t &ph, const uint8_t pct) {
+  uint32_t count = 0;
+  LOOP_L_N(i, PROFILE_BUCKETS) count += ph.bucket[i];
+  const uint32_t rank = (count * pct + 99) / 100;
+  uint32_t seen = 0;
+  LOOP_L_N(i, PROFILE_BUCKETS) {
+    seen += ph.bucket[i];
+    if (seen >= rank) return _MIN(bucket_end(i) - 1, ph.max);
+  }
+  return ph.max;
+}
+
+// On LINUX the ISR time is host time and the print time is simulated,
+// so this is the load the host would have printing in real time.
+float StepperProfile::load_percent() {
+  const millis_t ms = millis() - since;
+  const bool was_enabled = stepper.suspend();
+  const uint64_t total = phase[PROFILE_ISR].total;
+  if (was_enabled) stepper.wake_up();
+  return ms ? total / PROFILE_TICKS_PER_US / ms / 10 : 0;
+}
+
+void StepperProfile::report() {
+  static const char * const names[] = {
+    "isr", "pulse", "block"
+    #if HAS_LA_ISR
+      , "advance"
+    #endif
+    #if ENABLED(INTEGRATED_BABYSTEPPING)
+      , "babystep"
+    #endif
+    #if ENABLED(INPUT_SHAPING)
+      , "shaping"
+    #endif
+  };
+  static_assert(COUNT(names) == PROFILE_PHASES, "Name every ProfilePhase.");
+
+  const millis_t ms = millis() - since;
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("Stepper ISR profile (us) over ", ms, "ms");
+
+  LOOP_L_N(p, PROFILE_PHASES) {
+    // Copy the counts, so the ISR can't change them halfway through
+    const bool was_enabled = stepper.suspend();
+    const phase_t ph = phase[p];
+    if (was_enabled) stepper.wake_up();
+
+    if (!ph.calls) continue;
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHO(names[p]);
+    SERIAL_ECHOPAIR(" calls:", ph.calls);
+    SERIAL_ECHOPAIR_F(" min:", ph.min / PROFILE_TICKS_PER_US, 2);
+    SERIAL_ECHOPAIR_F(" avg:", ph.total / PROFILE_TICKS_PER_US / ph.calls, 2);
+    SERIAL_ECHOPAIR_F(" p99:", percentile(ph, 99) / PROFILE_TICKS_PER_US, 2);
+    SERIAL_ECHOPAIR_F(" max:", ph.max / PROFILE_TICKS_PER_US, 2);
+    SERIAL_EOL();
+  }
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR_F("ISR load:", load_percent(), 2);
+  SERIAL_ECHOLNPGM("%");
+}
+
+#endif // STEPPER_ISR_PROFILE
@@ -0,0 +1,146 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Stepper ISR profile
+ *
+ * Min / avg / p99 / max time of the stepper ISR and of each of its phases,
+ * from the cheapest clock the platform has: the DWT cycle counter on
+ * Cortex-M3 and up, the host's monotonic clock on LINUX, and the step
+ * timer count everywhere else (TCNT1 on AVR). The step ISR sets the timer
+ * compare to the max as it starts, so the count doesn't wrap while it runs.
+ *
+ * p99 comes from a histogram of 4 buckets per power of 2, so it reads up
+ * to 1/8 high.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#ifdef __PLAT_LINUX__
+  #include <time.h>
+#endif
+
+enum ProfilePhase : uint8_t {
+  PROFILE_ISR,          // Stepper::isr(), or the HAL's stream playback ISR
+  PROFILE_PULSE,        // pulse_phase_isr()
+  PROFILE_BLOCK,        // block_phase_isr()
+  #if HAS_LA_ISR
+    PROFILE_ADVANCE,    // advance_isr()
+  #endif
+  #if ENABLED(INTEGRATED_BABYSTEPPING)
+    PROFILE_BABYSTEP,   // babystepping_isr()
+  #endif
+  #if ENABLED(INPUT_SHAPING)
+    PROFILE_SHAPING,    // shaping_isr()
+  #endif
+  PROFILE_PHASES
+};
+
+#ifdef __PLAT_LINUX__
+
+  // Nanoseconds. The monotonic clock is read in user space, without a system call.
+  typedef uint32_t profile_ticks_t;
+  #define PROFILE_TICKS_PER_US 1000.0f
+  FORCE_INLINE static profile_ticks_t profile_ticks() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return profile_ticks_t(ts.tv_sec) * 1000000000UL + ts.tv_nsec;
+  }
+
+#elif (defined(__arm__) || defined(__thumb__)) && __CORTEX_M >= 3 && defined(DWT)
+
+  // CPU cycles
+  typedef uint32_t profile_ticks_t;
+  #define PROFILE_TICKS_PER_US ((F_CPU) / 1000000.0f)
+  FORCE_INLINE static profile_ticks_t profile_ticks() { return DWT->CYCCNT; }
+  #define PROFILE_CYCLE_COUNTER
+
+#else
+
+  // Step timer ticks
+  typedef hal_timer_t profile_ticks_t;
+  #define PROFILE_TICKS_PER_US float(STEPPER_TIMER_TICKS_PER_US)
+  FORCE_INLINE static profile_ticks_t profile_ticks() { return HAL_timer_get_count(STEP_TIMER_NUM); }
+
+#endif
+
+#define PROFILE_BUCKETS 64  // Up to 2^17 ticks, longer times go in the last bucket
+
+class StepperProfile {
+public:
+  typedef struct {
+    uint32_t calls, min, max;
+    uint64_t total;
+    uint16_t bucket[PROFILE_BUCKETS];
+  } phase_t;
+
+  static phase_t phase[PROFILE_PHASES];
+  static millis_t since;  // Time of the last reset, for the ISR load
+
+  static void init();
+  static void reset();
+  static void report();
+
+  static uint32_t percentile(const phase_t &ph, const uint8_t pct);
+  static float load_percent();  // Share of the time since the reset spent in the step ISR
+
+  // Count one run of a phase. Called from the stepper ISR.
+  static void add(const ProfilePhase p, const uint32_t ticks) {
+    phase_t &ph = phase[p];
+    ph.calls++;
+    ph.total += ticks;
+    NOMORE(ph.min, ticks);
+    NOLESS(ph.max, ticks);
+    // Halve a full histogram, so its shape holds
+    if (++ph.bucket[bucket_index(ticks)] == 0xFFFF)
+      LOOP_L_N(i, PROFILE_BUCKETS) ph.bucket[i] >>= 1;
+  }
+
+  // Time a phase up to the end of the enclosing scope
+  class Scope {
+  public:
+    FORCE_INLINE Scope(const ProfilePhase p) : p(p), start(profile_ticks()) {}
+    FORCE_INLINE ~Scope() { add(p, profile_ticks_t(profile_ticks() - start)); }
+  private:
+    const ProfilePhase p;
+    const profile_ticks_t start;
+  };
+
+private:
+  // Buckets 0-3 hold 0-3 ticks, then 4 buckets for each power of 2
+  static inline uint8_t bucket_index(const uint32_t ticks) {
+    if (ticks < 4) return ticks;
+    const uint8_t o = 8 * sizeof(long) - 1 - __builtin_clzl(ticks);  // 2^o <= ticks
+    const uint8_t i = 4 * (o - 1) + ((ticks >> (o - 2)) & 3);
+    return i < PROFILE_BUCKETS ? i : PROFILE_BUCKETS - 1;
+  }
+
+  // The first tick count past a bucket
+  static inline uint32_t bucket_end(const uint8_t i) {
+    return i < 4 ? i + 1 : uint32_t(5 + (i & 3)) << (i / 4 - 1);
+  }
+};
+
+extern StepperProfile stepper_profile;
+
+#define STEPPER_PROFILE(P) StepperProfile::Scope stepper_profile_scope(PROFILE_##P)
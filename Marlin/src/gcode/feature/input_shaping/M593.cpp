@@ -0,0 +1,99 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(INPUT_SHAPING)
+
+#include "../../gcode.h"
+#include "../../../module/stepper.h"
+
+/**
+ * M593: Get or Set Input Shaping
+ *  X           Change the X axis shaper
+ *  Y           Change the Y axis shaper (Both when neither is given)
+ *  F<hz>       Resonant frequency. 0 disables shaping.
+ *  D<zeta>     Damping ratio, 0 to 0.5
+ *  T<type>     Shaper: 0 = ZV, 1 = ZVD, 2 = MZV, 3 = EI
+ */
+void GcodeSuite::M593() {
+
+  auto echo_value_oor = [](const char ltr) {
+    SERIAL_CHAR('?', ltr);
+    SERIAL_ECHOLNPGM(" value out of range.");
+  };
+
+  const bool seen_x = parser.seen('X'), seen_y = parser.seen('Y');
+
+  LOOP_L_N(i, 2) {
+    const AxisEnum axis = i ? Y_AXIS : X_AXIS;
+    if ((seen_x || seen_y) && !(i ? seen_y : seen_x)) continue;
+
+    shaping_settings_t settings = stepper.get_shaping(axis);
+
+    if (parser.seenval('F')) {
+      const float F = parser.value_float();
+      if (F == 0 || F >= SHAPING_MIN_FREQ)
+        settings.frequency = F;
+      else
+        echo_value_oor('F');
+    }
+
+    if (parser.seenval('D')) {
+      const float D = parser.value_float();
+      if (WITHIN(D, 0, 0.5f))
+        settings.zeta = D;
+      else
+        echo_value_oor('D');
+    }
+
+    if (parser.seenval('T')) {
+      const uint8_t T = parser.value_byte();
+      if (T <= SHAPER_EI)
+        settings.type = ShaperType(T);
+      else
+        echo_value_oor('T');
+    }
+
+    const shaping_settings_t &old = stepper.get_shaping(axis);
+    if (settings.frequency != old.frequency || settings.zeta != old.zeta || settings.type != old.type)
+      stepper.set_shaping(axis, settings);
+  }
+
+  if (!parser.seen("FDT")) {
+    static const char * const types[] = { "ZV", "ZVD", "MZV", "EI" };
+    LOOP_L_N(i, 2) {
+      const shaping_settings_t &settings = stepper.get_shaping(i ? Y_AXIS : X_AXIS);
+      SERIAL_ECHO_START();
+      SERIAL_ECHOPAIR("Input Shaping ", axis_codes[i], ": ");
+      if (settings.frequency > 0) {
+        SERIAL_ECHO(types[settings.type]);
+        SERIAL_ECHOLNPAIR(" F", settings.frequency, " D", settings.zeta);
+      }
+      else
+        SERIAL_ECHOLNPGM("off");
+    }
+  }
+
+}
+
+#endif // INPUT_SHAPING
@@ -20,31 +20,22 @@
  *
  */
 
-#ifdef __PLAT_LINUX__
+#include "../../../inc/MarlinConfig.h"
 
-#include "IOLoggerCSV.h"
+#if ENABLED(STEPPER_ISR_PROFILE)
 
-IOLoggerCSV::IOLoggerCSV(std::string filename) {
-  file.open(filename);
-}
-
-IOLoggerCSV::~IOLoggerCSV() {
-  file.close();
-}
+#include "../../gcode.h"
+#include "../../../feature/stepper_profile.h"
 
-void IOLoggerCSV::log(GpioEvent ev) {
-  std::lock_guard<std::mutex> lock(vector_lock);
-  events.push_back(ev); //minimal impact to signal handler
-}
-
-void IOLoggerCSV::flush() {
-  { std::lock_guard<std::mutex> lock(vector_lock);
-    while (!events.empty()) {
-      file << events.front().timestamp << ", "<< events.front().pin_id << ", " << events.front().event << std::endl;
-      events.pop_front();
-    }
-  }
-  file.flush();
+/**
+ * M124: Report the Stepper ISR profile
+ *  R   Reset the counts instead
+ */
+void GcodeSuite::M124() {
+  if (parser.seen('R'))
+    stepper_profile.reset();
+  else
+    stepper_profile.report();
 }
 
-#endif // __PLAT_LINUX__
+#endif // STEPPER_ISR_PROFILE
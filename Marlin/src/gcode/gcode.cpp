@@ -417,6 +417,8 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         #endif
 
         case 928: M928(); break;                                  // M928: Start SD write
+      #elif ENABLED(BINARY_MOTION)
+        case 28: M28(); break;                                    // M28 B1: Start the binary motion stream
       #endif // SDSUPPORT
 
       case 31: M31(); break;                                      // M31: Report time since the start of SD print or last M109
@@ -494,6 +496,14 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 155: M155(); break;                                  // M155: Set temperature auto-report interval
       #endif
 
+      #if ENABLED(PLANNER_STATS)
+        case 123: M123(); break;                                  // M123: Report planner statistics
+      #endif
+
+      #if ENABLED(STEPPER_ISR_PROFILE)
+        case 124: M124(); break;                                  // M124: Report the stepper ISR profile
+      #endif
+
       #if ENABLED(PARK_HEAD_ON_PAUSE)
         case 125: M125(); break;                                  // M125: Store current position and move to filament change position
       #endif
@@ -726,6 +736,10 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 575: M575(); break;                                  // M575: Set serial baudrate
       #endif
 
+      #if ENABLED(INPUT_SHAPING)
+        case 593: M593(); break;                                  // M593: Set Input Shaping
+      #endif
+
       #if ENABLED(ADVANCED_PAUSE_FEATURE)
         case 600: M600(); break;                                  // M600: Pause for Filament Change
         case 603: M603(); break;                                  // M603: Configure Filament Change
@@ -889,7 +903,7 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
  * This is called from the main loop()
  */
 void GcodeSuite::process_next_command() {
-  char * const current_command = queue.command_buffer[queue.index_r];
+  char * const current_command = queue.command();
 
   PORT_REDIRECT(queue.port[queue.index_r]);
 
@@ -902,12 +916,17 @@ void GcodeSuite::process_next_command() {
     SERIAL_ECHOLN(current_command);
     #if ENABLED(M100_FREE_MEMORY_DUMPER)
       SERIAL_ECHOPAIR("slot:", queue.index_r);
-      M100_dump_routine(PSTR("   Command Queue:"), &queue.command_buffer[0][0], &queue.command_buffer[BUFSIZE - 1][MAX_CMD_SIZE - 1]);
+      M100_dump_routine(PSTR("   Command Queue:"), (const char*)queue.command_buffer, (const char*)queue.command_buffer + sizeof(queue.command_buffer) - 1);
     #endif
   }
 
   // Parse the next command in the queue
-  parser.parse(current_command);
+  {
+    #ifdef HAL_BENCHMARK
+      HAL_BENCH_SCOPE(parse);
+    #endif
+    parser.parse(current_command);
+  }
   process_parsed_command();
 }
 
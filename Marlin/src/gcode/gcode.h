@@ -145,6 +145,8 @@
  * M120 - Enable endstops detection.
  * M121 - Disable endstops detection.
  * M122 - Debug stepper (Requires at least one _DRIVER_TYPE defined as TMC2130/2160/5130/5160/2208/2209/2660 or L6470)
+ * M123 - Report planner buffer depth, starvation and recalculate time. "M123 R" to reset. (Requires PLANNER_STATS)
+ * M124 - Report the stepper ISR time per phase and the ISR load. "M124 R" to reset. (Requires STEPPER_ISR_PROFILE)
  * M125 - Save current position and move to filament change position. (Requires PARK_HEAD_ON_PAUSE)
  * M126 - Solenoid Air Valve Open. (Requires BARICUDA)
  * M127 - Solenoid Air Valve Closed. (Requires BARICUDA)
@@ -226,6 +228,7 @@
  * M524 - Abort the current SD print job started with M24. (Requires SDSUPPORT)
  * M540 - Enable/disable SD card abort on endstop hit: "M540 S<state>". (Requires SD_ABORT_ON_ENDSTOP_HIT)
  * M569 - Enable stealthChop on an axis. (Requires at least one _DRIVER_TYPE to be TMC2130/2160/2208/2209/5130/5160)
+ * M593 - Get or set Input Shaping: "M593 [X] [Y] F<hz> D<zeta> T<type>". (Requires INPUT_SHAPING)
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
  * M605 - Set Dual X-Carriage movement mode: "M605 S<mode> [X<x_offset>] [R<temp_offset>]". (Requires DUAL_X_CARRIAGE)
@@ -543,6 +546,8 @@ private:
     static void M28();
     static void M29();
     static void M30();
+  #elif ENABLED(BINARY_MOTION)
+    static void M28();
   #endif
 
   static void M31();
@@ -629,6 +634,14 @@ private:
   static void M120();
   static void M121();
 
+  #if ENABLED(PLANNER_STATS)
+    static void M123();
+  #endif
+
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    static void M124();
+  #endif
+
   #if ENABLED(PARK_HEAD_ON_PAUSE)
     static void M125();
   #endif
@@ -853,6 +866,10 @@ private:
     static void M575();
   #endif
 
+  #if ENABLED(INPUT_SHAPING)
+    static void M593();
+  #endif
+
   #if ENABLED(ADVANCED_PAUSE_FEATURE)
     static void M600();
     static void M603();
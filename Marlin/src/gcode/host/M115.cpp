@@ -56,6 +56,9 @@ void GcodeSuite::M115() {
     // SERIAL_XON_XOFF
     cap_line(PSTR("SERIAL_XON_XOFF"), ENABLED(SERIAL_XON_XOFF));
 
+    // SERIAL_CREDITS
+    cap_line(PSTR("SERIAL_CREDITS"), ENABLED(SERIAL_CREDITS));
+
     // BINARY_FILE_TRANSFER (M28 B1)
     cap_line(PSTR("BINARY_FILE_TRANSFER"), ENABLED(BINARY_FILE_TRANSFER));
 
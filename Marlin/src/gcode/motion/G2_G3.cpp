@@ -40,6 +40,25 @@
   #define N_ARC_CORRECTION 1
 #endif
 
+#if ENABLED(ARC_BLOCKS)
+
+  // Whether the soft endstops leave the whole circle alone, as a block can't be clipped
+  static bool circle_within_limits(const xy_pos_t &center, const float &radius, const float &z1, const float &z2) {
+    #if HAS_SOFTWARE_ENDSTOPS
+      const xyz_pos_t lo = { center.x - radius, center.y - radius, _MIN(z1, z2) },
+                      hi = { center.x + radius, center.y + radius, _MAX(z1, z2) };
+      xyz_pos_t lo_limited = lo, hi_limited = hi;
+      apply_motion_limits(lo_limited);
+      apply_motion_limits(hi_limited);
+      LOOP_XYZ(i) if (lo_limited[i] != lo[i] || hi_limited[i] != hi[i]) return false;
+    #else
+      UNUSED(center); UNUSED(radius); UNUSED(z1); UNUSED(z2);
+    #endif
+    return true;
+  }
+
+#endif
+
 /**
  * Plan an arc in 2 dimensions
  *
@@ -48,6 +67,9 @@
  * Arcs should only be made relatively large (over 5mm), as larger arcs with
  * larger segments will tend to be more efficient. Your slicer should have
  * options for G2/G3 arc generation. In future these options may be GCode tunable.
+ *
+ * With ARC_BLOCKS the planner takes the arc as a single block instead,
+ * and the Stepper ISR steps along the same chords.
  */
 void plan_arc(
   const xyze_pos_t &cart,   // Destination position
@@ -117,6 +139,19 @@ void plan_arc(
   uint16_t segments = FLOOR(mm_of_travel / seg_length);
   NOLESS(segments, min_segments);
 
+  #if ENABLED(ARC_BLOCKS)
+    // Queue the arc as one block, if it's in the XY plane and needs no leveling or clipping
+    if (p_axis == X_AXIS && !planner.leveling_active
+      && circle_within_limits({ center_P, center_Q }, radius, current_position.z, cart.z)
+    ) {
+      const arc_t arc = { { center_P, center_Q }, radius, angular_travel / segments, segments };
+      if (planner.buffer_arc(cart, arc, scaled_fr_mm_s, active_extruder, mm_of_travel)) {
+        current_position = cart;
+        return;
+      }
+    }
+  #endif
+
   /**
    * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
    * and phi is the angle of rotation. Based on the solution approach by Jens Geisler.
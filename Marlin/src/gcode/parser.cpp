@@ -112,6 +112,79 @@ void GCodeParser::reset() {
 
 #endif
 
+/**
+ * Parse a plain decimal number into the correctly rounded float. It
+ * needs at most 24 bits of digits (trailing zeros don't count) and 10
+ * decimals, so both sides of the one division are exact. That covers
+ * slicer output, and anything else returns false for strtof() to do.
+ */
+static bool fast_float(const char *p, float &ret) {
+  static const float pow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+  constexpr uint32_t mantissa_max = 1UL << 24;
+
+  const bool neg = *p == '-';
+  if (neg || *p == '+') p++;
+
+  uint32_t m = 0;                     // Digits so far, less any trailing zeros
+  uint8_t decimals = 0, zeros = 0;    // Digits of m after the point, zeros not in m yet
+  bool point = false, digits = false;
+  char c;
+  for (;; p++) {
+    c = *p;
+    if (c == '0') {
+      zeros++;
+      digits = true;
+    }
+    else if (NUMERIC(c) || (c == '.' && !point)) {
+      for (; zeros; zeros--) {        // Zeros are only significant with a digit after them
+        if (m > mantissa_max / 10) return false;
+        m *= 10;
+        if (point) decimals++;
+      }
+      if (c == '.')
+        point = true;
+      else {
+        if (m > mantissa_max / 10) return false;
+        m = m * 10 + (c - '0');
+        if (point) decimals++;
+        digits = true;
+      }
+    }
+    else
+      break;
+  }
+
+  // Integer zeros count, and hex or "inf" / "nan" are left to strtof()
+  if (!point) for (; zeros; zeros--) {
+    if (m > mantissa_max / 10) return false;
+    m *= 10;
+  }
+  if (!digits || c == 'x' || c == 'X' || m > mantissa_max || decimals >= COUNT(pow10)) return false;
+
+  ret = decimals ? float(m) / pow10[decimals] : float(m);
+  if (neg) ret = -ret;
+  return true;
+}
+
+float GCodeParser::parse_float(char * const str) {
+  float ret;
+  if (fast_float(str, ret)) return ret;
+
+  char *e = str;
+  for (;;) {
+    const char c = *e;
+    if (c == '\0' || c == ' ') break;
+    if (c == 'E' || c == 'e') {
+      *e = '\0';
+      ret = strtof(str, nullptr);
+      *e = c;
+      return ret;
+    }
+    ++e;
+  }
+  return strtof(str, nullptr);
+}
+
 // Populate all fields by parsing a single line of GCode
 // 58 bytes of SRAM are used to speed up seen/value
 void GCodeParser::parse(char *p) {
@@ -244,25 +244,11 @@ public:
   // The value as a string
   static inline char* value_string() { return value_ptr; }
 
+  // Parse a float the way strtof() would, but without scientific notation
+  static float parse_float(char * const str);
+
   // Float removes 'E' to prevent scientific notation interpretation
-  static inline float value_float() {
-    if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, nullptr);
-          *e = c;
-          return ret;
-        }
-        ++e;
-      }
-      return strtof(value_ptr, nullptr);
-    }
-    return 0;
-  }
+  static inline float value_float() { return value_ptr ? parse_float(value_ptr) : 0; }
 
   // Code value as a long or ulong
   static inline int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
@@ -39,7 +39,7 @@ GCodeQueue queue;
   #include "../feature/leds/printer_event_leds.h"
 #endif
 
-#if ENABLED(BINARY_FILE_TRANSFER)
+#if HAS_BINARY_STREAM
   #include "../feature/binary_protocol.h"
 #endif
 
@@ -54,6 +54,18 @@ GCodeQueue queue;
  */
 long gcode_N, GCodeQueue::last_N;
 
+#if ENABLED(SERIAL_CREDITS)
+  // Set by a resend request, until the requested line comes
+  static bool resend_pending;
+
+  // Lines the RX buffer can hold at their longest
+  #ifdef RX_BUFFER_SIZE
+    #define RX_LINES ((RX_BUFFER_SIZE) / (MAX_CMD_SIZE))
+  #else
+    #define RX_LINES 0
+  #endif
+#endif
+
 /**
  * GCode Command Queue
  * A simple ring buffer of BUFSIZE command strings.
@@ -67,7 +79,13 @@ uint8_t GCodeQueue::length = 0,  // Count of commands in the queue
         GCodeQueue::index_r = 0, // Ring buffer read position
         GCodeQueue::index_w = 0; // Ring buffer write position
 
-char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
+#ifdef BUFSIZE_BYTES
+  char GCodeQueue::command_buffer[BUFSIZE_BYTES];
+  uint16_t GCodeQueue::cmd_r, // = 0
+           GCodeQueue::cmd_w; // = 0
+#else
+  char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
+#endif
 
 /*
  * The port that the command was received on
@@ -83,6 +101,34 @@ char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
 // Number of characters read in the current line of serial input
 static int serial_count[NUM_SERIAL] = { 0 };
 
+/**
+ * Serial lines are read straight into the command queue, one port at a
+ * time, and checked as they come in. A line moves to serial_line_buffer
+ * when the port can't have the queue space, or when another command has
+ * to go into the queue before the line is complete.
+ *
+ * The binary stream also uses serial_line_buffer to receive packets.
+ */
+static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
+static int8_t serial_in_place = -1;       // The port reading into the queue, if any
+
+static struct {
+  char *line;                             // The line being read, in the queue or serial_line_buffer
+  uint8_t lead,                           // Leading spaces, which the checksum leaves out
+          checksum,                       // XOR of the line so far
+          star,                           // Length up to the last '*', 0 for none
+          star_checksum;                  // Checksum of the line before that '*'
+} serial_line[NUM_SERIAL];
+
+// Make way for another command by moving a line being read in place to its buffer
+static void spill_serial_line() {
+  if (serial_in_place < 0) return;
+  auto &sl = serial_line[serial_in_place];
+  memcpy(serial_line_buffer[serial_in_place], sl.line, serial_count[serial_in_place]);
+  sl.line = serial_line_buffer[serial_in_place];
+  serial_in_place = -1;
+}
+
 bool send_ok[BUFSIZE];
 
 /**
@@ -108,17 +154,67 @@ bool GCodeQueue::has_commands_queued() {
  * Clear the Marlin command queue
  */
 void GCodeQueue::clear() {
+  spill_serial_line();
   index_r = index_w = length = 0;
+  #ifdef BUFSIZE_BYTES
+    cmd_r = cmd_w = 0;
+  #endif
+}
+
+/**
+ * Get the space for the next command, 'size' bytes with the terminator.
+ * Once the command is written there, _commit_command adds it to the queue.
+ * Return nullptr if the queue is full.
+ */
+char* GCodeQueue::command_space(const uint16_t size/*=MAX_CMD_SIZE*/) {
+  if (length >= BUFSIZE) return nullptr;
+  #ifdef BUFSIZE_BYTES
+    const uint16_t need = size + 1;                   // Size byte and command
+    if (cmd_w < cmd_r || (length && cmd_w == cmd_r)) {
+      if (cmd_r - cmd_w < need) return nullptr;       // Not enough left before the read position
+    }
+    else if (BUFSIZE_BYTES - cmd_w < need) {
+      if (cmd_r < need) return nullptr;               // Not enough at the start either
+      if (cmd_w < BUFSIZE_BYTES) command_buffer[cmd_w] = 0; // Mark the end unused
+      cmd_w = 0;
+    }
+    return &command_buffer[cmd_w + 1];
+  #else
+    UNUSED(size);
+    return command_buffer[index_w];
+  #endif
 }
 
+#if ENABLED(SERIAL_CREDITS)
+
+  uint8_t GCodeQueue::free_lines() {
+    #ifdef BUFSIZE_BYTES
+      // Up to MAX_CMD_SIZE may go unused where the buffer wraps
+      const uint16_t used = cmd_w > cmd_r || !length ? cmd_w - cmd_r : BUFSIZE_BYTES - cmd_r + cmd_w,
+                     space = BUFSIZE_BYTES - used;
+      const uint8_t fit = space > MAX_CMD_SIZE ? (space - MAX_CMD_SIZE) / (MAX_CMD_SIZE + 1) : 0;
+      return _MIN(fit, BUFSIZE - length);
+    #else
+      return BUFSIZE - length;
+    #endif
+  }
+
+#endif
+
 /**
  * Once a new command is in the ring buffer, call this to commit it
  */
-void GCodeQueue::_commit_command(bool say_ok
+void GCodeQueue::_commit_command(const uint16_t size, bool say_ok
   #if NUM_SERIAL > 1
     , int16_t p/*=-1*/
   #endif
 ) {
+  #ifdef BUFSIZE_BYTES
+    command_buffer[cmd_w] = size;
+    cmd_w += size + 1;
+  #else
+    UNUSED(size);
+  #endif
   send_ok[index_w] = say_ok;
   #if NUM_SERIAL > 1
     port[index_w] = p;
@@ -128,6 +224,9 @@ void GCodeQueue::_commit_command(bool say_ok
   #endif
   if (++index_w >= BUFSIZE) index_w = 0;
   length++;
+  #ifdef HAL_BENCHMARK
+    HAL_BENCH_ERROR(queue_depth, length);
+  #endif
 }
 
 /**
@@ -140,9 +239,13 @@ bool GCodeQueue::_enqueue(const char* cmd, bool say_ok/*=false*/
     , int16_t pn/*=-1*/
   #endif
 ) {
-  if (*cmd == ';' || length >= BUFSIZE) return false;
-  strcpy(command_buffer[index_w], cmd);
-  _commit_command(say_ok
+  if (*cmd == ';') return false;
+  spill_serial_line();
+  const uint16_t size = strlen(cmd) + 1;
+  char * const buff = command_space(size);
+  if (!buff) return false;
+  memcpy(buff, cmd, size);
+  _commit_command(size, say_ok
     #if NUM_SERIAL > 1
       , pn
     #endif
@@ -253,6 +356,10 @@ void GCodeQueue::enqueue_now_P(PGM_P const pgcode) {
  *   N<int>  Line number of the command, if any
  *   P<int>  Planner space remaining
  *   B<int>  Block queue space remaining
+ *
+ * If SERIAL_CREDITS is enabled also include:
+ *   N<int>  Line number of the command, if any
+ *   C<int>  Highest line number the host may send
  */
 void GCodeQueue::ok_to_send() {
   #if NUM_SERIAL > 1
@@ -262,17 +369,23 @@ void GCodeQueue::ok_to_send() {
   #endif
   if (!send_ok[index_r]) return;
   SERIAL_ECHOPGM(STR_OK);
-  #if ENABLED(ADVANCED_OK)
-    char* p = command_buffer[index_r];
+  #if EITHER(ADVANCED_OK, SERIAL_CREDITS)
+    char* p = command();
     if (*p == 'N') {
       SERIAL_ECHO(' ');
       SERIAL_ECHO(*p++);
       while (NUMERIC_SIGNED(*p))
         SERIAL_ECHO(*p++);
     }
+  #endif
+  #if ENABLED(ADVANCED_OK)
     SERIAL_ECHOPAIR_P(SP_P_STR, int(planner.moves_free()));
     SERIAL_ECHOPAIR(" B", int(BUFSIZE - length));
   #endif
+  #if ENABLED(SERIAL_CREDITS)
+    // Lines past last_N wait in the queue or, at worst MAX_CMD_SIZE each, in the RX buffer
+    SERIAL_ECHOPAIR(" C", last_N + free_lines() + RX_LINES);
+  #endif
   SERIAL_EOL();
 }
 
@@ -289,6 +402,9 @@ void GCodeQueue::flush_and_request_resend() {
   SERIAL_FLUSH();
   SERIAL_ECHOPGM(STR_RESEND);
   SERIAL_ECHOLN(last_N + 1);
+  #if ENABLED(SERIAL_CREDITS)
+    resend_pending = true;
+  #endif
   ok_to_send();
 }
 
@@ -326,6 +442,13 @@ FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", b
   return m29 && !NUMERIC(m29[3]);
 }
 
+#if HAS_BINARY_STREAM
+  FORCE_INLINE bool is_M28_binary(const char * const cmd) { // matches "M28 B1", after which the port speaks binary
+    const char * const m28 = strstr_P(cmd, PSTR("M28 B"));
+    return m28 && m28[5] > '0';
+  }
+#endif
+
 #define PS_NORMAL 0
 #define PS_EOL    1
 #define PS_QUOTED 2
@@ -396,18 +519,23 @@ inline bool process_line_done(uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind
  * left on the serial port.
  */
 void GCodeQueue::get_serial_commands() {
-  static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
-
   static uint8_t serial_input_state[NUM_SERIAL] = { PS_NORMAL };
 
-  #if ENABLED(BINARY_FILE_TRANSFER)
-    if (card.flag.binary_mode) {
+  #if HAS_BINARY_STREAM
+    // Hold the input after "M28 B1" until it runs, since the rest is binary
+    static bool binary_pending = false;
+    if (binary_pending) {
+      if (length) return;
+      binary_pending = false;
+    }
+
+    if (BinaryStream::active) {
       /**
        * For binary stream file transfer, use serial_line_buffer as the working
        * receive buffer (which limits the packet size to MAX_CMD_SIZE).
        * The receive buffer also limits the packet size for reliable transmission.
        */
-      binaryStream[card.transfer_port_index].receive(serial_line_buffer[card.transfer_port_index]);
+      binaryStream[BinaryStream::port].receive(serial_line_buffer[BinaryStream::port]);
       return;
     }
   #endif
@@ -426,23 +554,34 @@ void GCodeQueue::get_serial_commands() {
   /**
    * Loop while serial characters are incoming and the queue is not full
    */
-  while (length < BUFSIZE && serial_data_available()) {
+  while (command_space() && serial_data_available()) {
     LOOP_L_N(i, NUM_SERIAL) {
 
       const int c = read_serial(i);
       if (c < 0) continue;
 
       const char serial_char = c;
+      auto &sl = serial_line[i];
+
+      // A new line goes into the queue, unless another port is there already
+      if (!serial_count[i] && serial_in_place != i) {
+        char * const space = serial_in_place < 0 ? command_space() : nullptr;
+        if (space) serial_in_place = i;
+        sl.line = space ?: serial_line_buffer[i];
+      }
+      char (&line)[MAX_CMD_SIZE] = *(char (*)[MAX_CMD_SIZE])sl.line;
 
       if (ISEOL(serial_char)) {
 
+        const uint8_t lead = sl.lead, star = sl.star, star_checksum = sl.star_checksum;
+        sl.lead = sl.checksum = sl.star = 0;
+        const uint16_t size = serial_count[i] + 1;
+
         // Reset our state, continue if the line was empty
-        if (process_line_done(serial_input_state[i], serial_line_buffer[i], serial_count[i]))
+        if (process_line_done(serial_input_state[i], line, serial_count[i]))
           continue;
 
-        char* command = serial_line_buffer[i];
-
-        while (*command == ' ') command++;                   // Skip leading spaces
+        char* command = line + lead;                         // Skip leading spaces
         char *npos = (*command == 'N') ? command : nullptr;  // Require the N parameter to start the line
 
         if (npos) {
@@ -456,20 +595,26 @@ void GCodeQueue::get_serial_commands() {
 
           gcode_N = strtol(npos + 1, nullptr, 10);
 
-          if (gcode_N != last_N + 1 && !M110)
+          if (gcode_N != last_N + 1 && !M110) {
+            #if ENABLED(SERIAL_CREDITS)
+              // The host sent these before it saw the resend request
+              if (resend_pending) continue;
+            #endif
             return gcode_line_error(PSTR(STR_ERR_LINE_NO), i);
+          }
 
-          char *apos = strrchr(command, '*');
-          if (apos) {
-            uint8_t checksum = 0, count = uint8_t(apos - command);
-            while (count) checksum ^= command[--count];
-            if (strtol(apos + 1, nullptr, 10) != checksum)
+          // The checksum was worked out as the line came in
+          if (star) {
+            if (strtol(line + star, nullptr, 10) != star_checksum)
               return gcode_line_error(PSTR(STR_ERR_CHECKSUM_MISMATCH), i);
           }
           else
             return gcode_line_error(PSTR(STR_ERR_NO_CHECKSUM), i);
 
           last_N = gcode_N;
+          #if ENABLED(SERIAL_CREDITS)
+            resend_pending = false;
+          #endif
         }
         #if ENABLED(SDSUPPORT)
           // Pronterface "M29" and "M29 " has no line number
@@ -516,15 +661,44 @@ void GCodeQueue::get_serial_commands() {
           last_command_time = ms;
         #endif
 
-        // Add the command to the queue
-        _enqueue(serial_line_buffer[i], true
-          #if NUM_SERIAL > 1
-            , i
-          #endif
-        );
+        // Add the command to the queue, where it may be already
+        if (serial_in_place == i) {
+          _commit_command(size, true
+            #if NUM_SERIAL > 1
+              , i
+            #endif
+          );
+          serial_in_place = -1;
+        }
+        else
+          _enqueue(line, true
+            #if NUM_SERIAL > 1
+              , i
+            #endif
+          );
+
+        #if HAS_BINARY_STREAM
+          if (is_M28_binary(command)) {
+            binary_pending = true;
+            return;
+          }
+        #endif
+      }
+      else {
+        const int count = serial_count[i];
+        process_stream_char(serial_char, serial_input_state[i], line, serial_count[i]);
+        if (serial_count[i] > count) {                       // Kept, so add it to the checksum
+          if (serial_char == ' ' && count == sl.lead)
+            sl.lead++;
+          else {
+            if (serial_char == '*') {
+              sl.star = count + 1;
+              sl.star_checksum = sl.checksum;
+            }
+            sl.checksum ^= serial_char;
+          }
+        }
       }
-      else
-        process_stream_char(serial_char, serial_input_state[i], serial_line_buffer[i], serial_count[i]);
 
     } // for NUM_SERIAL
   } // queue has space, serial has data
@@ -543,9 +717,13 @@ void GCodeQueue::get_serial_commands() {
 
     if (!IS_SD_PRINTING()) return;
 
+    spill_serial_line();
+
     int sd_count = 0;
     bool card_eof = card.eof();
-    while (length < BUFSIZE && !card_eof) {
+    char *buff;
+    while (!card_eof && (buff = command_space())) {
+      char (&command)[MAX_CMD_SIZE] = *(char (*)[MAX_CMD_SIZE])buff;
       const int16_t n = card.get();
       card_eof = card.eof();
       if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
@@ -556,8 +734,9 @@ void GCodeQueue::get_serial_commands() {
 
         // Reset stream state, terminate the buffer, and commit a non-empty command
         if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
-        if (!process_line_done(sd_input_state, command_buffer[index_w], sd_count)) {
-          _commit_command(false);
+        const uint16_t size = sd_count + 1;
+        if (!process_line_done(sd_input_state, command, sd_count)) {
+          _commit_command(size, false);
           #if ENABLED(POWER_LOSS_RECOVERY)
             recovery.cmd_sdpos = card.getIndex();     // Prime for the NEXT _commit_command
           #endif
@@ -566,7 +745,7 @@ void GCodeQueue::get_serial_commands() {
         if (card_eof) card.fileHasFinished();         // Handle end of file reached
       }
       else
-        process_stream_char(sd_char, sd_input_state, command_buffer[index_w], sd_count);
+        process_stream_char(sd_char, sd_input_state, command, sd_count);
 
     }
   }
@@ -602,7 +781,7 @@ void GCodeQueue::advance() {
   #if ENABLED(SDSUPPORT)
 
     if (card.flag.saving) {
-      char* command = command_buffer[index_r];
+      char* command = queue.command();
       if (is_M29(command)) {
         // M29 closes the file
         card.closefile();
@@ -642,4 +821,15 @@ void GCodeQueue::advance() {
   --length;
   if (++index_r >= BUFSIZE) index_r = 0;
 
+  #ifdef BUFSIZE_BYTES
+    if (length) {
+      cmd_r += uint8_t(command_buffer[cmd_r]) + 1;
+      if (cmd_r >= BUFSIZE_BYTES || !command_buffer[cmd_r]) cmd_r = 0;
+    }
+    else if (serial_in_place < 0)
+      cmd_r = cmd_w = 0;                                // Empty, so start over at the front
+    else
+      cmd_r = cmd_w;                                    // Empty, but a serial line is coming in at cmd_w
+  #endif
+
 }
@@ -49,7 +49,29 @@ public:
   static uint8_t length,  // Count of commands in the queue
                  index_r; // Ring buffer read position
 
-  static char command_buffer[BUFSIZE][MAX_CMD_SIZE];
+  #ifdef BUFSIZE_BYTES
+    /**
+     * Commands are stored back to back, each after a byte holding its
+     * size with the terminator. A zero size marks the unused end of the
+     * buffer where the next command didn't fit, so it went to the start.
+     */
+    static char command_buffer[BUFSIZE_BYTES];
+    static uint16_t cmd_r,  // Buffer position of the command at index_r
+                    cmd_w;  // Buffer position of the command at index_w
+  #else
+    static char command_buffer[BUFSIZE][MAX_CMD_SIZE];
+  #endif
+
+  /**
+   * The command at index_r
+   */
+  static inline char* command() {
+    #ifdef BUFSIZE_BYTES
+      return &command_buffer[cmd_r + 1];
+    #else
+      return command_buffer[index_r];
+    #endif
+  }
 
   /*
    * The port that the command was received on
@@ -114,6 +136,10 @@ public:
    *   N<int>  Line number of the command, if any
    *   P<int>  Planner space remaining
    *   B<int>  Block queue space remaining
+   *
+   * If SERIAL_CREDITS is enabled also include:
+   *   N<int>  Line number of the command, if any
+   *   C<int>  Highest line number the host may send
    */
   static void ok_to_send();
 
@@ -127,13 +153,22 @@ private:
 
   static uint8_t index_w;  // Ring buffer write position
 
+  // Space for a command of 'size' bytes, with the terminator, or nullptr if the queue is full
+  static char* command_space(const uint16_t size=MAX_CMD_SIZE);
+
+  #if ENABLED(SERIAL_CREDITS)
+    // Lines that still fit in the queue, however long they are
+    static uint8_t free_lines();
+  #endif
+
   static void get_serial_commands();
 
   #if ENABLED(SDSUPPORT)
     static void get_sdcard_commands();
   #endif
 
-  static void _commit_command(bool say_ok
+  // Add the command written to command_space(), 'size' bytes with the terminator
+  static void _commit_command(const uint16_t size, bool say_ok
     #if NUM_SERIAL > 1
       , int16_t p=-1
     #endif
@@ -38,6 +38,10 @@
   #include "../queue.h"
 #endif
 
+#if HAS_BINARY_STREAM
+  #include "../../feature/binary_protocol.h"
+#endif
+
 #define BCT_WAIT_BYTE_TIMEOUT 5000
 #define BCT_MAX_RAW_SIZE 512
 #define BCT_EOT 4
@@ -157,10 +161,11 @@ inline void receive_raw_file() {
  */
 void GcodeSuite::M28() {
 
-  #if ENABLED(BINARY_FILE_TRANSFER)
+  char *p = parser.string_arg;
+
+  #if HAS_BINARY_STREAM
 
     bool binary_mode = false;
-    char *p = parser.string_arg;
     if (p[0] == 'B' && NUMERIC(p[1])) {
       binary_mode = p[1] > '0';
       p += 2;
@@ -168,20 +173,28 @@ void GcodeSuite::M28() {
     }
 
     // Binary transfer mode
-    if ((card.flag.binary_mode = binary_mode)) {
-      SERIAL_ECHO_MSG("Switching to Binary Protocol");
-      #if NUM_SERIAL > 1
-        card.transfer_port_index = queue.port[queue.index_r];
-      #endif
+    if (binary_mode) {
+      BinaryStream::start(
+        #if NUM_SERIAL > 1
+          queue.port[queue.index_r]
+        #else
+          0
+        #endif
+      );
+      return;
     }
-    else
-      card.openFileWrite(p);
+
+  #endif
+
+  #if ENABLED(BINARY_FILE_TRANSFER)
+
+    card.openFileWrite(p);
 
   #else
 
     // raw data protocol, enabled by M28 !file_name
     bool saving_raw = false;
-    char *file = parser.string_arg;
+    char *file = p;
     if (file[0] == '!') {
       saving_raw = true;
       file++;
@@ -204,4 +217,28 @@ void GcodeSuite::M29() {
   card.flag.saving = false;
 }
 
+#elif ENABLED(BINARY_MOTION)
+
+#include "../gcode.h"
+#include "../../feature/binary_protocol.h"
+
+#if NUM_SERIAL > 1
+  #include "../queue.h"
+#endif
+
+/**
+ * M28 B1: Switch to the binary protocol, for the motion stream
+ */
+void GcodeSuite::M28() {
+  const char * const p = parser.string_arg;
+  if (p && p[0] == 'B' && p[1] > '0')
+    BinaryStream::start(
+      #if NUM_SERIAL > 1
+        queue.port[queue.index_r]
+      #else
+        0
+      #endif
+    );
+}
+
 #endif // SDSUPPORT
@@ -0,0 +1,81 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_STATS)
+
+#include "../gcode.h"
+#include "../../module/planner.h"
+#include "../../module/stepper.h"
+
+/**
+ * M123: Report the planner statistics
+ *
+ *  Buffer  - How many moves were queued each time the stepper took a block
+ *  Starved - Times the planner ran dry while printing. If commands were
+ *            "waiting" the parser, the planner or a command that waits
+ *            for the moves (G28, M400, M109...) held them up. Otherwise
+ *            the host or the SD card was late.
+ *  Recalculate - Time spent planning each new block
+ *  Reverse passes - Passes over the buffer, and how many went all the way back
+ *
+ *  R   Reset the counts instead
+ */
+void GcodeSuite::M123() {
+  const bool was_enabled = stepper.suspend();
+  if (parser.seen('R')) {
+    memset(&planner.stats, 0, sizeof(planner.stats));
+    stepper.starved = stepper.starved_waiting = 0;
+    if (was_enabled) stepper.wake_up();
+    return;
+  }
+
+  // Copy the counts, so the ISR can't change them halfway through
+  const Planner::planner_stats_t st = planner.stats;
+  const uint32_t starved = stepper.starved, starved_waiting = stepper.starved_waiting;
+  if (was_enabled) stepper.wake_up();
+
+  constexpr uint8_t bin_size = (BLOCK_BUFFER_SIZE) / (PLANNER_STATS_BINS);
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPGM("Buffer");
+  LOOP_L_N(i, PLANNER_STATS_BINS) {
+    SERIAL_CHAR(' ');
+    SERIAL_ECHO(int(i * bin_size));
+    if (bin_size > 1) SERIAL_ECHOPAIR("-", int((i + 1) * bin_size - 1));
+    SERIAL_ECHOPAIR(":", st.depth[i]);
+  }
+  SERIAL_EOL();
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("Starved:", starved, " waiting:", starved_waiting);
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("Recalculate calls:", st.recalculations,
+    " avg:", st.recalculations ? st.recalculate_us / st.recalculations : uint32_t(0),
+    "us max:", st.recalculate_max_us, "us");
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOLNPAIR("Reverse passes:", st.reverse_passes, " full:", st.reverse_passes - st.short_reverse_passes);
+}
+
+#endif // PLANNER_STATS
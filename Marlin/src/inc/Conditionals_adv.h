@@ -118,6 +118,8 @@
 
 #define HAS_CUTTER EITHER(SPINDLE_FEATURE, LASER_FEATURE)
 
+#define HAS_BINARY_STREAM EITHER(BINARY_FILE_TRANSFER, BINARY_MOTION)
+
 #if !defined(__AVR__) || !defined(USBCON)
   // Define constants and variables for buffering serial data.
   // Use only 0 or powers of 2 greater than 1
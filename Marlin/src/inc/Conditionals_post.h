@@ -35,6 +35,24 @@
   #define HAS_LINEAR_E_JERK 1
 #endif
 
+// Linear advance steps E from a stepper ISR phase of its own, or with the other axes
+#if DISABLED(LIN_ADVANCE)
+  #undef LA_MERGE_STEPS
+#elif DISABLED(LA_MERGE_STEPS)
+  #define HAS_LA_ISR 1
+#endif
+
+// The planner keeps a running total of the queued motion time
+#if HAS_SPI_LCD || defined(PLANNER_HORIZON_MS)
+  #define HAS_BLOCK_RUNTIME 1
+#endif
+
+// Steps that can be awaiting a replay by the input shaper. The longest
+// shaper lasts 1/(f*sqrt(1-zeta^2)), under 1.16 periods for zeta <= 0.5.
+#if ENABLED(INPUT_SHAPING)
+  #define SHAPING_BUFFER_SIZE (uint32_t((SHAPING_MAX_STEPRATE) * 1.16f / (SHAPING_MIN_FREQ)) + 2)
+#endif
+
 // Determine which type of 'EEPROM' is in use
 #if ENABLED(EEPROM_SETTINGS)
   // EEPROM type may be defined by compile flags, configs, HALs, or pins
@@ -527,6 +527,27 @@
   #error "SERIAL_XON_XOFF and SERIAL_STATS_* features not supported on USB-native AVR devices."
 #endif
 
+/**
+ * Command queue
+ */
+#if BUFSIZE < 1 || BUFSIZE > 255
+  #error "BUFSIZE must be between 1 and 255."
+#endif
+#ifdef BUFSIZE_BYTES
+  #if MAX_CMD_SIZE > 255
+    #error "BUFSIZE_BYTES requires MAX_CMD_SIZE <= 255."
+  #elif BUFSIZE_BYTES <= MAX_CMD_SIZE || BUFSIZE_BYTES > 65535
+    #error "BUFSIZE_BYTES must be more than MAX_CMD_SIZE and at most 65535."
+  #endif
+#endif
+#if ENABLED(SERIAL_CREDITS)
+  #if BUFSIZE < 2
+    #error "SERIAL_CREDITS requires BUFSIZE >= 2."
+  #elif defined(BUFSIZE_BYTES) && BUFSIZE_BYTES < 3 * (MAX_CMD_SIZE + 1)
+    #error "SERIAL_CREDITS requires BUFSIZE_BYTES >= 3 * (MAX_CMD_SIZE + 1)."
+  #endif
+#endif
+
 #if SERIAL_PORT > 7
   #error "Set SERIAL_PORT to the port on your board. Usually this is 0."
 #endif
@@ -937,6 +958,81 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   );
 #endif
 
+/**
+ * Step Schedule
+ */
+#if ENABLED(STEP_SCHEDULE)
+  #ifdef __AVR__
+    #error "STEP_SCHEDULE requires a 32-bit MCU."
+  #elif !defined(STEP_SCHEDULE_SIZE)
+    #error "STEP_SCHEDULE requires STEP_SCHEDULE_SIZE."
+  #endif
+  static_assert(WITHIN(STEP_SCHEDULE_SIZE, 2, 0xFFFF), "STEP_SCHEDULE_SIZE must be from 2 to 65535.");
+#endif
+
+/**
+ * Step Stream
+ */
+#if ENABLED(STEP_STREAM)
+  #ifndef HAL_STEP_STREAM
+    #error "STEP_STREAM is not supported by this HAL."
+  #elif ENABLED(I2S_STEPPER_STREAM)
+    #error "STEP_STREAM is not compatible with I2S_STEPPER_STREAM."
+  #elif ENABLED(INPUT_SHAPING)
+    #error "STEP_STREAM is not compatible with INPUT_SHAPING."
+  #elif ENABLED(INTEGRATED_BABYSTEPPING)
+    #error "STEP_STREAM is not compatible with INTEGRATED_BABYSTEPPING."
+  #elif ENABLED(MIXING_EXTRUDER)
+    #error "STEP_STREAM is not compatible with MIXING_EXTRUDER."
+  #elif HAS_L64XX
+    #error "STEP_STREAM is not compatible with L64XX drivers."
+  #elif !defined(STEP_STREAM_SIZE) || !defined(STEP_STREAM_BATCH) || !defined(STEP_STREAM_AHEAD)
+    #error "STEP_STREAM requires STEP_STREAM_SIZE, STEP_STREAM_BATCH and STEP_STREAM_AHEAD."
+  #endif
+  static_assert(!((STEP_STREAM_SIZE) & ((STEP_STREAM_SIZE) - 1)), "STEP_STREAM_SIZE must be a power of 2.");
+  static_assert(STEP_STREAM_SIZE > 128 * (1 + ENABLED(LIN_ADVANCE)) + 1, "STEP_STREAM_SIZE must be at least 256, or 512 with LIN_ADVANCE.");
+  static_assert(WITHIN(STEP_STREAM_BATCH, 1, (STEP_STREAM_SIZE) - 1), "STEP_STREAM_BATCH must be from 1 to STEP_STREAM_SIZE - 1.");
+  static_assert(STEP_STREAM_AHEAD > 0, "STEP_STREAM_AHEAD must be greater than 0.");
+#endif
+
+/**
+ * Stepper ISR Profile
+ */
+#if BOTH(STEPPER_ISR_PROFILE, I2S_STEPPER_STREAM)
+  #error "STEPPER_ISR_PROFILE is not compatible with I2S_STEPPER_STREAM."
+#endif
+
+/**
+ * Input Shaping
+ */
+#if ENABLED(INPUT_SHAPING)
+  #if IS_KINEMATIC
+    #error "INPUT_SHAPING is not compatible with DELTA or SCARA."
+  #elif ENABLED(I2S_STEPPER_STREAM)
+    #error "INPUT_SHAPING is not compatible with I2S_STEPPER_STREAM."
+  #elif !defined(SHAPING_MIN_FREQ) || !defined(SHAPING_MAX_STEPRATE)
+    #error "INPUT_SHAPING requires SHAPING_MIN_FREQ and SHAPING_MAX_STEPRATE."
+  #endif
+  static_assert(SHAPING_MIN_FREQ > 0, "SHAPING_MIN_FREQ must be greater than 0.");
+  static_assert(SHAPING_BUFFER_SIZE <= 0xFFFF, "SHAPING_MAX_STEPRATE / SHAPING_MIN_FREQ is too large. Raise SHAPING_MIN_FREQ.");
+  static_assert(
+    (SHAPING_FREQ_X == 0 || SHAPING_FREQ_X >= SHAPING_MIN_FREQ) && (SHAPING_FREQ_Y == 0 || SHAPING_FREQ_Y >= SHAPING_MIN_FREQ),
+    "SHAPING_FREQ_[XY] must be 0 or at least SHAPING_MIN_FREQ."
+  );
+  static_assert(WITHIN(SHAPING_ZETA_X, 0, 0.5) && WITHIN(SHAPING_ZETA_Y, 0, 0.5), "SHAPING_ZETA_[XY] must be a value from 0 to 0.5.");
+#endif
+
+/**
+ * Arc Blocks
+ */
+#if ENABLED(ARC_BLOCKS)
+  #if DISABLED(ARC_SUPPORT)
+    #error "ARC_BLOCKS requires ARC_SUPPORT."
+  #elif IS_KINEMATIC || IS_CORE
+    #error "ARC_BLOCKS requires a Cartesian machine."
+  #endif
+#endif
+
 /**
  * Special tool-changing options
  */
@@ -1108,6 +1204,13 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "CLASSIC_JERK is required for DELTA and SCARA."
 #endif
 
+/**
+ * Segment coalescing works on Cartesian step positions
+ */
+#if ENABLED(COALESCE_SEGMENTS) && IS_KINEMATIC
+  #error "COALESCE_SEGMENTS is not compatible with DELTA or SCARA."
+#endif
+
 /**
  * Probes
  */
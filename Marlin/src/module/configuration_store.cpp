@@ -37,7 +37,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V76"
+#define EEPROM_VERSION "V77"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -373,6 +373,13 @@ typedef struct SettingsDataStruct {
   uint8_t backlash_correction;                          // M425 F
   float backlash_smoothing_mm;                          // M425 S
 
+  //
+  // INPUT_SHAPING
+  //
+  #if ENABLED(INPUT_SHAPING)
+    shaping_settings_t shaping_settings[2];             // M593 X Y F D T
+  #endif
+
   //
   // EXTENSIBLE_UI
   //
@@ -1313,6 +1320,15 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(backlash_smoothing_mm);
     }
 
+    //
+    // Input Shaping
+    //
+    #if ENABLED(INPUT_SHAPING)
+      _FIELD_TEST(shaping_settings);
+      EEPROM_WRITE(stepper.get_shaping(X_AXIS));
+      EEPROM_WRITE(stepper.get_shaping(Y_AXIS));
+    #endif
+
     //
     // Extensible UI User Data
     //
@@ -2173,6 +2189,21 @@ void MarlinSettings::postprocess() {
         EEPROM_READ(backlash_smoothing_mm);
       }
 
+      //
+      // Input Shaping
+      //
+      #if ENABLED(INPUT_SHAPING)
+      {
+        shaping_settings_t shaping_settings[2];
+        _FIELD_TEST(shaping_settings);
+        EEPROM_READ(shaping_settings);
+        if (!validating) {
+          stepper.set_shaping(X_AXIS, shaping_settings[0]);
+          stepper.set_shaping(Y_AXIS, shaping_settings[1]);
+        }
+      }
+      #endif
+
       //
       // Extensible UI User Data
       //
@@ -2476,6 +2507,11 @@ void MarlinSettings::reset() {
     toolchange_settings.z_raise = TOOLCHANGE_ZRAISE;
   #endif
 
+  #if ENABLED(INPUT_SHAPING)
+    stepper.set_shaping(X_AXIS, { SHAPING_TYPE, SHAPING_FREQ_X, SHAPING_ZETA_X });
+    stepper.set_shaping(Y_AXIS, { SHAPING_TYPE, SHAPING_FREQ_Y, SHAPING_ZETA_Y });
+  #endif
+
   #if ENABLED(BACKLASH_GCODE)
     backlash.correction = (BACKLASH_CORRECTION) * 255;
     constexpr xyz_float_t tmp = BACKLASH_DISTANCE_MM;
@@ -3656,6 +3692,19 @@ void MarlinSettings::reset() {
       M217_report(true);
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      CONFIG_ECHO_HEADING("Input Shaping:");
+      LOOP_L_N(i, 2) {
+        const shaping_settings_t &settings = stepper.get_shaping(i ? Y_AXIS : X_AXIS);
+        CONFIG_ECHO_START();
+        SERIAL_ECHOLNPAIR_P(
+            i ? PSTR("  M593 Y T") : PSTR("  M593 X T"), int(settings.type)
+          , PSTR(" F"), settings.frequency
+          , PSTR(" D"), settings.zeta
+        );
+      }
+    #endif
+
     #if ENABLED(BACKLASH_GCODE)
       CONFIG_ECHO_HEADING("Backlash compensation:");
       CONFIG_ECHO_START();
@@ -120,13 +120,18 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
-volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be pushed
+block_plan_t Planner::block_plan[BLOCK_BUFFER_SIZE];
+volatile block_index_t Planner::block_buffer_head,    // Index of the next block to be pushed
                  Planner::block_buffer_nonbusy, // Index of the first non-busy block
                  Planner::block_buffer_planned, // Index of the optimally planned block
                  Planner::block_buffer_tail;    // Index of the busy block, if any
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
 uint8_t Planner::delay_before_delivering;       // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
+#if ENABLED(PLANNER_STATS)
+  Planner::planner_stats_t Planner::stats; // = { 0 }
+#endif
+
 planner_settings_t Planner::settings;           // Initialized by settings.load()
 
 uint32_t Planner::max_acceleration_steps_per_s2[XYZE_N]; // (steps/s^2) Derived from mm_per_s2
@@ -202,8 +207,19 @@ uint32_t Planner::cutoff_long;
 xyze_float_t Planner::previous_speed;
 float Planner::previous_nominal_speed_sqr;
 
+#if DISABLED(CLASSIC_JERK)
+  xyze_float_t Planner::previous_unit_vec;
+#endif
+#if HAS_CLASSIC_JERK
+  float Planner::previous_safe_speed;
+#endif
+
+#if ENABLED(COALESCE_SEGMENTS)
+  Planner::coalesce_t Planner::coalesce;
+#endif
+
 #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
-  uint8_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
+  Planner::last_move_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
 #endif
 
 #ifdef XY_FREQUENCY_LIMIT
@@ -225,7 +241,7 @@ float Planner::previous_nominal_speed_sqr;
   xyze_pos_t Planner::position_cart;
 #endif
 
-#if HAS_SPI_LCD
+#if HAS_BLOCK_RUNTIME
   volatile uint32_t Planner::block_buffer_runtime_us = 0;
 #endif
 
@@ -719,7 +735,7 @@ void Planner::init() {
  */
 block_t* Planner::get_current_block() {
   // Get the number of moves in the planner queue so far
-  const uint8_t nr_moves = movesplanned();
+  const block_index_t nr_moves = movesplanned();
 
   // If there are any moves queued ...
   if (nr_moves) {
@@ -739,8 +755,8 @@ block_t* Planner::get_current_block() {
     // No trapezoid calculated? Don't execute yet.
     if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
 
-    #if HAS_SPI_LCD
-      block_buffer_runtime_us -= block->segment_time_us; // We can't be sure how long an active block will take, so don't count it.
+    #if HAS_BLOCK_RUNTIME
+      block_buffer_runtime_us -= block_plan[block_buffer_tail].segment_time_us; // We can't be sure how long an active block will take, so don't count it.
     #endif
 
     // As this block is busy, advance the nonbusy block pointer
@@ -750,12 +766,16 @@ block_t* Planner::get_current_block() {
     if (block_buffer_tail == block_buffer_planned)
       block_buffer_planned = block_buffer_nonbusy;
 
+    #if ENABLED(PLANNER_STATS)
+      stats.depth[nr_moves / ((BLOCK_BUFFER_SIZE) / (PLANNER_STATS_BINS))]++;
+    #endif
+
     // Return the block
     return block;
   }
 
   // The queue became empty
-  #if HAS_SPI_LCD
+  #if HAS_BLOCK_RUNTIME
     clear_block_buffer_runtime(); // paranoia. Buffer is empty now - so reset accumulated time to zero.
   #endif
 
@@ -836,6 +856,99 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
   block->final_rate = final_rate;
 }
 
+#if ENABLED(PLANNER_FIXED_POINT)
+
+  /**
+   * The same with integer math, from the entry and exit speeds squared.
+   * Over a block at constant acceleration the speed squared changes in
+   * proportion to distance, so step counts are differences of speed squared
+   * scaled by a per-block constant, and only the step rates at the ends need
+   * a square root. Same PRECONDITION as above.
+   */
+  void Planner::calculate_trapezoid_for_block(block_t* const block, const speed_sqr_t entry_speed_sqr, const speed_sqr_t exit_speed_sqr) {
+
+    const block_plan_t &plan = plan_of(block);
+    const speed_sqr_t nominal_speed_sqr = plan.nominal_speed_sqr_fixed;
+
+    uint32_t initial_rate = rate_for_speed_sqr(plan, _MIN(entry_speed_sqr, nominal_speed_sqr)),
+             final_rate = rate_for_speed_sqr(plan, _MIN(exit_speed_sqr, nominal_speed_sqr)); // (steps per second)
+
+    // Limit minimal step rate (Otherwise the timer will overflow.)
+    NOLESS(initial_rate, uint32_t(MINIMAL_STEP_RATE));
+    NOLESS(final_rate, uint32_t(MINIMAL_STEP_RATE));
+
+    #if ENABLED(S_CURVE_ACCELERATION)
+      uint32_t cruise_rate = initial_rate;
+    #endif
+
+            // Steps required for acceleration, deceleration to/from nominal rate
+    uint32_t accelerate_steps = entry_speed_sqr < nominal_speed_sqr ? steps_for_speed_sqr(plan, nominal_speed_sqr - entry_speed_sqr, true) : 0,
+             decelerate_steps = exit_speed_sqr < nominal_speed_sqr ? steps_for_speed_sqr(plan, nominal_speed_sqr - exit_speed_sqr, false) : 0;
+            // Steps between acceleration and deceleration, if any
+    int32_t plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
+
+    // No room to reach the nominal rate. Accelerating from the entry speed and braking
+    // to the exit speed meet at a peak where speed squared is the mean of the two ends
+    // plus half the change over the whole block.
+    if (plateau_steps < 0) {
+      const uint64_t peak_speed_sqr = (uint64_t(entry_speed_sqr) + exit_speed_sqr + plan.accel_speed_sqr) >> 1;
+      accelerate_steps = peak_speed_sqr > entry_speed_sqr ? steps_for_speed_sqr(plan, _MIN(peak_speed_sqr - entry_speed_sqr, uint64_t(SPEED_SQR_MAX)), true) : 0;
+      NOMORE(accelerate_steps, block->step_event_count);
+      plateau_steps = 0;
+
+      #if ENABLED(S_CURVE_ACCELERATION)
+        // We won't reach the cruising rate. Let's calculate the speed we will reach
+        cruise_rate = _MAX(rate_for_speed_sqr(plan, _MIN(peak_speed_sqr, uint64_t(nominal_speed_sqr))), initial_rate, final_rate);
+      #endif
+    }
+    #if ENABLED(S_CURVE_ACCELERATION)
+      else // We have some plateau time, so the cruise rate will be the nominal rate
+        cruise_rate = block->nominal_rate;
+    #endif
+
+    #if ENABLED(S_CURVE_ACCELERATION)
+      // Jerk controlled speed requires to express speed versus time, NOT steps
+      uint32_t acceleration_time = (uint64_t(cruise_rate - initial_rate) * plan.timer_per_rate) >> 16,
+               deceleration_time = (uint64_t(cruise_rate - final_rate) * plan.timer_per_rate) >> 16;
+
+      // And to offload calculations from the ISR, we also calculate the inverse of those times here
+      uint32_t acceleration_time_inverse = get_period_inverse(acceleration_time);
+      uint32_t deceleration_time_inverse = get_period_inverse(deceleration_time);
+    #endif
+
+    // Store new block parameters
+    block->accelerate_until = accelerate_steps;
+    block->decelerate_after = accelerate_steps + plateau_steps;
+    block->initial_rate = initial_rate;
+    #if ENABLED(S_CURVE_ACCELERATION)
+      block->acceleration_time = acceleration_time;
+      block->deceleration_time = deceleration_time;
+      block->acceleration_time_inverse = acceleration_time_inverse;
+      block->deceleration_time_inverse = deceleration_time_inverse;
+      block->cruise_rate = cruise_rate;
+    #endif
+    block->final_rate = final_rate;
+
+    #if ENABLED(LIN_ADVANCE)
+      if (block->use_advance_lead)
+        block->final_adv_steps = (uint64_t(final_rate) * block->adv_steps_per_rate) >> 24;
+    #endif
+
+    #ifdef HAL_BENCHMARK
+      // Measure against the float kernel, planning a copy of the block
+      block_t ref;
+      memcpy(&ref, block, sizeof(ref));
+      const float nomr = 1.0f / SQRT(plan.nominal_speed_sqr);
+      calculate_trapezoid_for_block(&ref, SQRT(SPEED_SQR_TO_FLOAT(entry_speed_sqr)) * nomr, SQRT(SPEED_SQR_TO_FLOAT(exit_speed_sqr)) * nomr);
+      HAL_BENCH_ERROR(trapezoid_step_error, _MAX(ABS(int32_t(block->accelerate_until - ref.accelerate_until)), ABS(int32_t(block->decelerate_after - ref.decelerate_after))));
+      // (The peak rate of a block without cruise isn't compared: the float kernel
+      // takes it from the rounded step count, this one from the speeds.)
+      HAL_BENCH_ERROR(trapezoid_rate_error, _MAX(ABS(int32_t(initial_rate - ref.initial_rate)) / float(ref.initial_rate), ABS(int32_t(final_rate - ref.final_rate)) / float(ref.final_rate)));
+    #endif
+  }
+
+#endif // PLANNER_FIXED_POINT
+
 /*                            PLANNER SPEED DEFINITION
                                      +--------+   <- current->nominal_speed
                                     /          \
@@ -901,15 +1014,17 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
 // The kernel called by recalculate() when scanning the plan from last to first entry.
 void Planner::reverse_pass_kernel(block_t* const current, const block_t * const next) {
   if (current) {
+    block_plan_t &plan = plan_of(current);
+
     // If entry speed is already at the maximum entry speed, and there was no change of speed
     // in the next block, there is no need to recheck. Block is cruising and there is no need to
     // compute anything for this block,
     // If not, block entry speed needs to be recalculated to ensure maximum possible planned speed.
-    const float max_entry_speed_sqr = current->max_entry_speed_sqr;
+    const speed_sqr_t max_entry_speed_sqr = plan.max_entry_speed_sqr;
 
     // Compute maximum entry speed decelerating over the current block from its exit speed.
     // If not at the maximum entry speed, or the previous block entry speed changed
-    if (current->entry_speed_sqr != max_entry_speed_sqr || (next && TEST(next->flag, BLOCK_BIT_RECALCULATE))) {
+    if (plan.entry_speed_sqr != max_entry_speed_sqr || (next && TEST(next->flag, BLOCK_BIT_RECALCULATE))) {
 
       // If nominal length true, max junction speed is guaranteed to be reached.
       // If a block can de/ac-celerate from nominal speed to zero within the length of the block, then
@@ -919,10 +1034,10 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t * const
       // the reverse and forward planners, the corresponding block junction speed will always be at the
       // the maximum junction speed and may always be ignored for any speed reduction checks.
 
-      const float new_entry_speed_sqr = TEST(current->flag, BLOCK_BIT_NOMINAL_LENGTH)
+      const speed_sqr_t new_entry_speed_sqr = TEST(current->flag, BLOCK_BIT_NOMINAL_LENGTH)
         ? max_entry_speed_sqr
-        : _MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-current->acceleration, next ? next->entry_speed_sqr : sq(float(MINIMUM_PLANNER_SPEED)), current->millimeters));
-      if (current->entry_speed_sqr != new_entry_speed_sqr) {
+        : _MIN(max_entry_speed_sqr, max_allowable_speed_sqr(plan, next ? plan_of(next).entry_speed_sqr : SPEED_SQR(sq(float(MINIMUM_PLANNER_SPEED)))));
+      if (plan.entry_speed_sqr != new_entry_speed_sqr) {
 
         // Need to recalculate the block speed - Mark it now, so the stepper
         // ISR does not consume the block before being recalculated
@@ -939,7 +1054,7 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t * const
         else {
           // Block is not BUSY so this is ahead of the Stepper ISR:
           // Just Set the new entry speed.
-          current->entry_speed_sqr = new_entry_speed_sqr;
+          plan.entry_speed_sqr = new_entry_speed_sqr;
         }
       }
     }
@@ -952,17 +1067,21 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t * const
  */
 void Planner::reverse_pass() {
   // Initialize block index to the last block in the planner buffer.
-  uint8_t block_index = prev_block_index(block_buffer_head);
+  block_index_t block_index = prev_block_index(block_buffer_head);
 
   // Read the index of the last buffer planned block.
   // The ISR may change it so get a stable local copy.
-  uint8_t planned_block_index = block_buffer_planned;
+  block_index_t planned_block_index = block_buffer_planned;
 
   // If there was a race condition and block_buffer_planned was incremented
   //  or was pointing at the head (queue empty) break loop now and avoid
   //  planning already consumed blocks
   if (planned_block_index == block_buffer_head) return;
 
+  #if ENABLED(PLANNER_STATS)
+    stats.reverse_passes++;
+  #endif
+
   // Reverse Pass: Coarsely maximize all possible deceleration curves back-planning from the last
   // block in buffer. Cease planning when the last optimal planned or tail pointer is reached.
   // NOTE: Forward pass will later refine and correct the reverse pass to create an optimal plan.
@@ -975,6 +1094,17 @@ void Planner::reverse_pass() {
     // Only consider non sync blocks
     if (!TEST(current->flag, BLOCK_BIT_SYNC_POSITION)) {
       reverse_pass_kernel(current, next);
+
+      // An entry speed the kernel left alone means the deceleration limit at this
+      // junction is the same as in the last plan, and so is every limit before it.
+      // With a deep buffer this keeps the pass as short as the newest block needs.
+      if (next && !TEST(current->flag, BLOCK_BIT_RECALCULATE)) {
+        #if ENABLED(PLANNER_STATS)
+          stats.short_reverse_passes++;
+        #endif
+        return;
+      }
+
       next = current;
     }
 
@@ -996,20 +1126,23 @@ void Planner::reverse_pass() {
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
-void Planner::forward_pass_kernel(const block_t* const previous, block_t* const current, const uint8_t block_index) {
+void Planner::forward_pass_kernel(const block_t* const previous, block_t* const current, const block_index_t block_index) {
   if (previous) {
+    const block_plan_t &previous_plan = plan_of(previous);
+    block_plan_t &plan = plan_of(current);
+
     // If the previous block is an acceleration block, too short to complete the full speed
     // change, adjust the entry speed accordingly. Entry speeds have already been reset,
     // maximized, and reverse-planned. If nominal length is set, max junction speed is
     // guaranteed to be reached. No need to recheck.
     if (!TEST(previous->flag, BLOCK_BIT_NOMINAL_LENGTH) &&
-      previous->entry_speed_sqr < current->entry_speed_sqr) {
+      previous_plan.entry_speed_sqr < plan.entry_speed_sqr) {
 
       // Compute the maximum allowable speed
-      const float new_entry_speed_sqr = max_allowable_speed_sqr(-previous->acceleration, previous->entry_speed_sqr, previous->millimeters);
+      const speed_sqr_t new_entry_speed_sqr = max_allowable_speed_sqr(previous_plan, previous_plan.entry_speed_sqr);
 
       // If true, current block is full-acceleration and we can move the planned pointer forward.
-      if (new_entry_speed_sqr < current->entry_speed_sqr) {
+      if (new_entry_speed_sqr < plan.entry_speed_sqr) {
 
         // Mark we need to recompute the trapezoidal shape, and do it now,
         // so the stepper ISR does not consume the block before being recalculated
@@ -1028,7 +1161,7 @@ void Planner::forward_pass_kernel(const block_t* const previous, block_t* const
           // Block is not BUSY, we won the race against the Stepper ISR:
 
           // Always <= max_entry_speed_sqr. Backward pass sets this.
-          current->entry_speed_sqr = new_entry_speed_sqr; // Always <= max_entry_speed_sqr. Backward pass sets this.
+          plan.entry_speed_sqr = new_entry_speed_sqr; // Always <= max_entry_speed_sqr. Backward pass sets this.
 
           // Set optimal plan pointer.
           block_buffer_planned = block_index;
@@ -1040,7 +1173,7 @@ void Planner::forward_pass_kernel(const block_t* const previous, block_t* const
     // point in the buffer. When the plan is bracketed by either the beginning of the
     // buffer and a maximum entry speed or two maximum entry speeds, every block in between
     // cannot logically be further improved. Hence, we don't have to recompute them anymore.
-    if (current->entry_speed_sqr == current->max_entry_speed_sqr)
+    if (plan.entry_speed_sqr == plan.max_entry_speed_sqr)
       block_buffer_planned = block_index;
   }
 }
@@ -1058,7 +1191,7 @@ void Planner::forward_pass() {
   //  by the stepper ISR,  so read it ONCE. It it guaranteed that block_buffer_planned
   //  will never lead head, so the loop is safe to execute. Also note that the forward
   //  pass will never modify the values at the tail.
-  uint8_t block_index = block_buffer_planned;
+  block_index_t block_index = block_buffer_planned;
 
   block_t *block;
   const block_t * previous = nullptr;
@@ -1088,17 +1221,23 @@ void Planner::forward_pass() {
  * according to the entry_factor for each junction. Must be called by
  * recalculate() after updating the blocks.
  */
-void Planner::recalculate_trapezoids() {
+void Planner::recalculate_trapezoids(const block_index_t planned_block_index) {
   // The tail may be changed by the ISR so get a local copy.
-  uint8_t block_index = block_buffer_tail,
-          head_block_index = block_buffer_head;
+  block_index_t block_index = block_buffer_tail,
+                head_block_index = block_buffer_head;
+
+  // Only blocks from the one ahead of the planned pointer (as it was before the
+  // passes) can have changed. Start there rather than walking the whole buffer.
+  if (planned_block_index != block_index && BLOCK_MOD(planned_block_index - block_index) < BLOCK_MOD(head_block_index - block_index))
+    block_index = prev_block_index(planned_block_index);
+
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
   while (head_block_index != block_index) {
 
     // Go back (head always point to the first free block)
-    const uint8_t prev_index = prev_block_index(head_block_index);
+    const block_index_t prev_index = prev_block_index(head_block_index);
 
     // Get the pointer to the block
     block_t *prev = &block_buffer[prev_index];
@@ -1112,14 +1251,22 @@ void Planner::recalculate_trapezoids() {
 
   // Go from the tail (currently executed block) to the first block, without including it)
   block_t *block = nullptr, *next = nullptr;
-  float current_entry_speed = 0.0, next_entry_speed = 0.0;
+  #if ENABLED(PLANNER_FIXED_POINT)
+    speed_sqr_t current_entry_speed_sqr = 0, next_entry_speed_sqr = 0;
+  #else
+    float current_entry_speed = 0.0, next_entry_speed = 0.0;
+  #endif
   while (block_index != head_block_index) {
 
     next = &block_buffer[block_index];
 
     // Skip sync blocks
     if (!TEST(next->flag, BLOCK_BIT_SYNC_POSITION)) {
-      next_entry_speed = SQRT(next->entry_speed_sqr);
+      #if ENABLED(PLANNER_FIXED_POINT)
+        next_entry_speed_sqr = block_plan[block_index].entry_speed_sqr;
+      #else
+        next_entry_speed = SQRT(block_plan[block_index].entry_speed_sqr);
+      #endif
 
       if (block) {
         // Recalculate if current block entry or exit junction speed has changed.
@@ -1136,16 +1283,25 @@ void Planner::recalculate_trapezoids() {
           if (!stepper.is_block_busy(block)) {
             // Block is not BUSY, we won the race against the Stepper ISR:
 
-            // NOTE: Entry and exit factors always > 0 by all previous logic operations.
-            const float current_nominal_speed = SQRT(block->nominal_speed_sqr),
-                        nomr = 1.0f / current_nominal_speed;
-            calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
-            #if ENABLED(LIN_ADVANCE)
-              if (block->use_advance_lead) {
-                const float comp = block->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
-                block->max_adv_steps = current_nominal_speed * comp;
-                block->final_adv_steps = next_entry_speed * comp;
-              }
+            #if ENABLED(STEP_SCHEDULE)
+              stepper.unschedule(block);
+            #endif
+
+            #if ENABLED(PLANNER_FIXED_POINT)
+              calculate_trapezoid_for_block(block, current_entry_speed_sqr, next_entry_speed_sqr);
+            #else
+              // NOTE: Entry and exit factors always > 0 by all previous logic operations.
+              const block_plan_t &plan = plan_of(block);
+              const float current_nominal_speed = SQRT(plan.nominal_speed_sqr),
+                          nomr = 1.0f / current_nominal_speed;
+              calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
+              #if ENABLED(LIN_ADVANCE)
+                if (block->use_advance_lead) {
+                  const float comp = plan.e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
+                  block->max_adv_steps = current_nominal_speed * comp;
+                  block->final_adv_steps = next_entry_speed * comp;
+                }
+              #endif
             #endif
           }
 
@@ -1156,7 +1312,11 @@ void Planner::recalculate_trapezoids() {
       }
 
       block = next;
-      current_entry_speed = next_entry_speed;
+      #if ENABLED(PLANNER_FIXED_POINT)
+        current_entry_speed_sqr = next_entry_speed_sqr;
+      #else
+        current_entry_speed = next_entry_speed;
+      #endif
     }
 
     block_index = next_block_index(block_index);
@@ -1176,15 +1336,24 @@ void Planner::recalculate_trapezoids() {
     if (!stepper.is_block_busy(block)) {
       // Block is not BUSY, we won the race against the Stepper ISR:
 
-      const float next_nominal_speed = SQRT(next->nominal_speed_sqr),
-                  nomr = 1.0f / next_nominal_speed;
-      calculate_trapezoid_for_block(next, next_entry_speed * nomr, float(MINIMUM_PLANNER_SPEED) * nomr);
-      #if ENABLED(LIN_ADVANCE)
-        if (next->use_advance_lead) {
-          const float comp = next->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
-          next->max_adv_steps = next_nominal_speed * comp;
-          next->final_adv_steps = (MINIMUM_PLANNER_SPEED) * comp;
-        }
+      #if ENABLED(STEP_SCHEDULE)
+        stepper.unschedule(next);
+      #endif
+
+      #if ENABLED(PLANNER_FIXED_POINT)
+        calculate_trapezoid_for_block(next, next_entry_speed_sqr, SPEED_SQR(sq(float(MINIMUM_PLANNER_SPEED))));
+      #else
+        const block_plan_t &plan = plan_of(next);
+        const float next_nominal_speed = SQRT(plan.nominal_speed_sqr),
+                    nomr = 1.0f / next_nominal_speed;
+        calculate_trapezoid_for_block(next, next_entry_speed * nomr, float(MINIMUM_PLANNER_SPEED) * nomr);
+        #if ENABLED(LIN_ADVANCE)
+          if (next->use_advance_lead) {
+            const float comp = plan.e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
+            next->max_adv_steps = next_nominal_speed * comp;
+            next->final_adv_steps = (MINIMUM_PLANNER_SPEED) * comp;
+          }
+        #endif
       #endif
     }
 
@@ -1195,14 +1364,28 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+  #ifdef HAL_BENCHMARK
+    HAL_BENCH_SCOPE(recalculate);
+  #endif
+  #if ENABLED(PLANNER_STATS)
+    const uint32_t start_us = micros();
+  #endif
   // Initialize block index to the last block in the planner buffer.
-  const uint8_t block_index = prev_block_index(block_buffer_head);
+  const block_index_t block_index = prev_block_index(block_buffer_head),
+                      planned_block_index = block_buffer_planned;
   // If there is just one block, no planning can be done. Avoid it!
-  if (block_index != block_buffer_planned) {
+  if (block_index != planned_block_index) {
     reverse_pass();
     forward_pass();
   }
-  recalculate_trapezoids();
+  recalculate_trapezoids(planned_block_index);
+
+  #if ENABLED(PLANNER_STATS)
+    const uint32_t us = micros() - start_us;
+    stats.recalculations++;
+    stats.recalculate_us += us;
+    NOLESS(stats.recalculate_max_us, us);
+  #endif
 }
 
 #if ENABLED(AUTOTEMP)
@@ -1214,10 +1397,10 @@ void Planner::recalculate() {
     if (thermalManager.degTargetHotend(0) + 2 < autotemp_min) return; // probably temperature set to zero.
 
     float high = 0.0;
-    for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+    for (block_index_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
       block_t* block = &block_buffer[b];
       if (block->steps.x || block->steps.y || block->steps.z) {
-        const float se = (float)block->steps.e / block->step_event_count * SQRT(block->nominal_speed_sqr); // mm/sec;
+        const float se = (float)block->steps.e / block->step_event_count * SQRT(block_plan[b].nominal_speed_sqr); // mm/sec;
         NOLESS(high, se);
       }
     }
@@ -1256,25 +1439,25 @@ void Planner::check_axes_activity() {
   if (has_blocks_queued()) {
 
     #if FAN_COUNT > 0 || ENABLED(BARICUDA)
-      block_t *block = &block_buffer[block_buffer_tail];
+      const block_plan_t &plan = block_plan[block_buffer_tail];
     #endif
 
     #if FAN_COUNT > 0
       FANS_LOOP(i)
-        tail_fan_speed[i] = thermalManager.scaledFanSpeed(i, block->fan_speed[i]);
+        tail_fan_speed[i] = thermalManager.scaledFanSpeed(i, plan.fan_speed[i]);
     #endif
 
     #if ENABLED(BARICUDA)
       #if HAS_HEATER_1
-        tail_valve_pressure = block->valve_pressure;
+        tail_valve_pressure = plan.valve_pressure;
       #endif
       #if HAS_HEATER_2
-        tail_e_to_p_pressure = block->e_to_p_pressure;
+        tail_e_to_p_pressure = plan.e_to_p_pressure;
       #endif
     #endif
 
     #if ANY(DISABLE_X, DISABLE_Y, DISABLE_Z, DISABLE_E)
-      for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+      for (block_index_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
         block_t *block = &block_buffer[b];
         LOOP_XYZE(i) if (block->steps[i]) axis_active[i] = true;
       }
@@ -1556,7 +1739,7 @@ void Planner::quick_stop() {
   // forced to empty, there's no risk the ISR will touch this.
   delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
 
-  #if HAS_SPI_LCD
+  #if HAS_BLOCK_RUNTIME
     // Clear the accumulated runtime
     clear_block_buffer_runtime();
   #endif
@@ -1581,7 +1764,11 @@ float Planner::triggered_position_mm(const AxisEnum axis) {
 }
 
 void Planner::finish_and_disable() {
-  while (has_blocks_queued() || cleaning_buffer_counter) idle();
+  while (has_blocks_queued() || cleaning_buffer_counter
+    #if ENABLED(INPUT_SHAPING)
+      || stepper.is_shaping()
+    #endif
+  ) idle();
   disable_all_steppers();
 }
 
@@ -1621,6 +1808,12 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 void Planner::synchronize() {
   while (
     has_blocks_queued() || cleaning_buffer_counter
+    #if ENABLED(INPUT_SHAPING)
+      || stepper.is_shaping()
+    #endif
+    #if ENABLED(STEP_STREAM)
+      || stepper.is_streaming()
+    #endif
     #if ENABLED(EXTERNAL_CLOSED_LOOP_CONTROLLER)
       || (READ(CLOSED_LOOP_ENABLE_PIN) && !READ(CLOSED_LOOP_MOVE_COMPLETE_PIN))
     #endif
@@ -1637,6 +1830,7 @@ void Planner::synchronize() {
  *  fr_mm_s       - (target) speed of the move
  *  extruder      - target extruder
  *  millimeters   - the length of the movement, if known
+ *  arc           - the arc to follow in X and Y, if any
  *
  * Returns true if movement was properly queued, false otherwise
  */
@@ -1648,15 +1842,23 @@ bool Planner::_buffer_steps(const xyze_long_t &target
     , const xyze_float_t &cart_dist_mm
   #endif
   , feedRate_t fr_mm_s, const uint8_t extruder, const float &millimeters
+  #if ENABLED(ARC_BLOCKS)
+    , const arc_t * const arc
+  #endif
 ) {
 
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_counter) return false;
 
   // Wait for the next available block
-  uint8_t next_buffer_head;
+  block_index_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
+  #if ENABLED(STEP_SCHEDULE)
+    // Drop the schedule of the last block in this slot
+    stepper.unschedule(block);
+  #endif
+
   // Fill the block with the specified movement
   if (!_populate_block(block, false, target
     #if HAS_POSITION_FLOAT
@@ -1666,6 +1868,9 @@ bool Planner::_buffer_steps(const xyze_long_t &target
       , cart_dist_mm
     #endif
     , fr_mm_s, extruder, millimeters
+    #if ENABLED(ARC_BLOCKS)
+      , arc
+    #endif
   )) {
     // Movement was not queued, probably because it was too short.
     //  Simply accept that as movement queued and done
@@ -1685,6 +1890,10 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
+  #ifdef HAL_BENCHMARK
+    HAL_BENCH_COUNT(blocks);
+  #endif
+
   // Recalculate and optimize trapezoidal speed profiles
   recalculate();
 
@@ -1700,6 +1909,7 @@ bool Planner::_buffer_steps(const xyze_long_t &target
  *  target      - target position in steps units
  *  fr_mm_s     - (target) speed of the move
  *  extruder    - target extruder
+ *  arc         - the arc to follow in X and Y, if any
  *
  * Returns true is movement is acceptable, false otherwise
  */
@@ -1712,8 +1922,13 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     , const xyze_float_t &cart_dist_mm
   #endif
   , feedRate_t fr_mm_s, const uint8_t extruder, const float &millimeters/*=0.0*/
+  #if ENABLED(ARC_BLOCKS)
+    , const arc_t * const arc/*=nullptr*/
+  #endif
 ) {
 
+  block_plan_t &plan = plan_of(block);
+
   const int32_t da = target.a - position.a,
                 db = target.b - position.b,
                 dc = target.c - position.c;
@@ -1877,8 +2092,56 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     e_move_accumulator += steps_dist_mm.e;
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    block->arc_chords = 0;
+    xy_float_t arc_end_dir{0};  // Direction of travel where the arc ends
+    float arc_mm = 0;           // Length of the arc in XY
+    if (arc) {
+      const float sx = settings.axis_steps_per_mm[X_AXIS], sy = settings.axis_steps_per_mm[Y_AXIS],
+                  turn = (arc->angle < 0 ? -1.0f : 1.0f) / arc->radius;
+      const xy_pos_t r0 = { position.x * steps_to_mm[X_AXIS] - arc->center.x, position.y * steps_to_mm[Y_AXIS] - arc->center.y },
+                     r1 = { target.x * steps_to_mm[X_AXIS] - arc->center.x, target.y * steps_to_mm[Y_AXIS] - arc->center.y };
+      const xy_float_t start_dir = { -r0.y * turn, r0.x * turn };
+      arc_end_dir.set(-r1.y * turn, r1.x * turn);
+      arc_mm = arc->radius * ABS(arc->angle) * arc->chords;
+
+      // Limit and join the block as a move of the arc's length, leaving along
+      // its start tangent. X and Y are set for the first chord by the stepper.
+      SET_BIT_TO(block->direction_bits, X_AXIS, start_dir.x < 0);
+      SET_BIT_TO(block->direction_bits, Y_AXIS, start_dir.y < 0);
+      block->steps.x = CEIL(arc_mm * sx);
+      block->steps.y = CEIL(arc_mm * sy);
+      steps_dist_mm.x = start_dir.x * arc_mm;
+      steps_dist_mm.y = start_dir.y * arc_mm;
+
+      // The stepper turns the radius vector from chord to chord, in steps
+      block->arc_chords = arc->chords;
+      block->arc_center.set(LROUND(arc->center.x * sx * _BV32(ARC_RADIUS_FRACT_BITS)), LROUND(arc->center.y * sy * _BV32(ARC_RADIUS_FRACT_BITS)));
+      block->arc_radius.set(position.x * int32_t(_BV32(ARC_RADIUS_FRACT_BITS)) - block->arc_center.x,
+                            position.y * int32_t(_BV32(ARC_RADIUS_FRACT_BITS)) - block->arc_center.y);
+      block->arc_end.set(target.x, target.y);
+      const float one = _BV32(ARC_ROTATE_FRACT_BITS), sin_T = sin(arc->angle);
+      block->arc_cos = LROUND(cos(arc->angle) * one);
+      block->arc_sin_x = LROUND(sin_T * sx / sy * one);
+      block->arc_sin_y = LROUND(sin_T * sy / sx * one);
+
+      // Give each chord enough events for the most steps X or Y take in it, plus
+      // rounding, and for the last chord, which goes to a target off the circle
+      const uint16_t chords = arc->chords;
+      const float last = arc->angle * (chords - 1), cos_L = cos(last), sin_L = sin(last),
+                  last_x = ABS(target.x - (arc->center.x + r0.x * cos_L - r0.y * sin_L) * sx),
+                  last_y = ABS(target.y - (arc->center.y + r0.x * sin_L + r0.y * cos_L) * sy);
+      uint32_t chord_events = CEIL(_MAX(arc->radius * ABS(arc->angle) * _MAX(sx, sy), last_x, last_y)) + 2;
+
+      // ...and share out Z and E over the whole arc
+      NOLESS(chord_events, (block->steps.z + chords - 1) / chords);
+      NOLESS(chord_events, (esteps + chords - 1) / chords);
+      block->arc_chord_events = chord_events;
+    }
+  #endif
+
   if (block->steps.a < MIN_STEPS_PER_SEGMENT && block->steps.b < MIN_STEPS_PER_SEGMENT && block->steps.c < MIN_STEPS_PER_SEGMENT) {
-    block->millimeters = (0
+    plan.millimeters = (0
       #if EXTRUDERS
         + ABS(steps_dist_mm.e)
       #endif
@@ -1886,9 +2149,9 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   }
   else {
     if (millimeters)
-      block->millimeters = millimeters;
+      plan.millimeters = millimeters;
     else
-      block->millimeters = SQRT(
+      plan.millimeters = SQRT(
         #if CORE_IS_XY
           sq(steps_dist_mm.head.x) + sq(steps_dist_mm.head.y) + sq(steps_dist_mm.z)
         #elif CORE_IS_XZ
@@ -1920,6 +2183,10 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
   block->step_event_count = _MAX(block->steps.a, block->steps.b, block->steps.c, esteps);
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) block->step_event_count = block->arc_chords * block->arc_chord_events;
+  #endif
+
   // Bail if this is a zero-length block
   if (block->step_event_count < MIN_STEPS_PER_SEGMENT) return false;
 
@@ -1932,12 +2199,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   #endif
 
   #if FAN_COUNT > 0
-    FANS_LOOP(i) block->fan_speed[i] = thermalManager.fan_speed[i];
+    FANS_LOOP(i) plan.fan_speed[i] = thermalManager.fan_speed[i];
   #endif
 
   #if ENABLED(BARICUDA)
-    block->valve_pressure = baricuda_valve_pressure;
-    block->e_to_p_pressure = baricuda_e_to_p_pressure;
+    plan.valve_pressure = baricuda_valve_pressure;
+    plan.e_to_p_pressure = baricuda_e_to_p_pressure;
   #endif
 
   #if EXTRUDERS > 1
@@ -2021,17 +2288,17 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   else
     NOLESS(fr_mm_s, settings.min_travel_feedrate_mm_s);
 
-  const float inverse_millimeters = 1.0f / block->millimeters;  // Inverse millimeters to remove multiple divides
+  const float inverse_millimeters = 1.0f / plan.millimeters;  // Inverse millimeters to remove multiple divides
 
   // Calculate inverse time for this move. No divide by zero due to previous checks.
   // Example: At 120mm/s a 60mm move takes 0.5s. So this will give 2.0.
   float inverse_secs = fr_mm_s * inverse_millimeters;
 
   // Get the number of non busy movements in queue (non busy means that they can be altered)
-  const uint8_t moves_queued = nonbusy_movesplanned();
+  const block_index_t moves_queued = nonbusy_movesplanned();
 
   // Slow down when the buffer starts to empty, rather than wait at the corner for a buffer refill
-  #if EITHER(SLOWDOWN, ULTRA_LCD) || defined(XY_FREQUENCY_LIMIT)
+  #if EITHER(SLOWDOWN, ULTRA_LCD) || defined(XY_FREQUENCY_LIMIT) || HAS_BLOCK_RUNTIME
     // Segment time im micro seconds
     uint32_t segment_time_us = LROUND(1000000.0f / inverse_secs);
   #endif
@@ -2045,24 +2312,24 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         // buffer is draining, add extra time.  The amount of time added increases if the buffer is still emptied more.
         const uint32_t nst = segment_time_us + LROUND(2 * (settings.min_segment_time_us - segment_time_us) / moves_queued);
         inverse_secs = 1000000.0f / nst;
-        #if defined(XY_FREQUENCY_LIMIT) || HAS_SPI_LCD
+        #if defined(XY_FREQUENCY_LIMIT) || HAS_BLOCK_RUNTIME
           segment_time_us = nst;
         #endif
       }
     }
   #endif
 
-  #if HAS_SPI_LCD
+  #if HAS_BLOCK_RUNTIME
     // Protect the access to the position.
     const bool was_enabled = stepper.suspend();
 
     block_buffer_runtime_us += segment_time_us;
-    block->segment_time_us = segment_time_us;
+    plan.segment_time_us = segment_time_us;
 
     if (was_enabled) stepper.wake_up();
   #endif
 
-  block->nominal_speed_sqr = sq(block->millimeters * inverse_secs);   // (mm/sec)^2 Always > 0
+  plan.nominal_speed_sqr = sq(plan.millimeters * inverse_secs);   // (mm/sec)^2 Always > 0
   block->nominal_rate = CEIL(block->step_event_count * inverse_secs); // (step/sec) Always > 0
 
   #if ENABLED(FILAMENT_WIDTH_SENSOR)
@@ -2102,6 +2369,18 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     }
   #endif
 
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) {
+      // X and Y may each take the whole speed somewhere on the arc, and
+      // the turn takes acceleration toward the center of v^2 / radius
+      const float arc_speed = arc_mm * inverse_secs,
+                  arc_accel = _MIN(esteps ? settings.acceleration : settings.travel_acceleration,
+                                   settings.max_acceleration_mm_per_s2[X_AXIS], settings.max_acceleration_mm_per_s2[Y_AXIS]),
+                  max_fr = _MIN(settings.max_feedrate_mm_s[X_AXIS], settings.max_feedrate_mm_s[Y_AXIS], SQRT(arc_accel * arc->radius));
+      if (arc_speed > max_fr) NOMORE(speed_factor, max_fr / arc_speed);
+    }
+  #endif
+
   // Max segment time in µs.
   #ifdef XY_FREQUENCY_LIMIT
 
@@ -2144,7 +2423,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   if (speed_factor < 1.0f) {
     current_speed *= speed_factor;
     block->nominal_rate *= speed_factor;
-    block->nominal_speed_sqr = block->nominal_speed_sqr * sq(speed_factor);
+    plan.nominal_speed_sqr = plan.nominal_speed_sqr * sq(speed_factor);
   }
 
   // Compute and limit the acceleration rate for the trapezoid generator.
@@ -2202,22 +2481,27 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
                               && de > 0;
 
       if (block->use_advance_lead) {
-        block->e_D_ratio = (target_float.e - position_float.e) /
+        plan.e_D_ratio = (target_float.e - position_float.e) /
           #if IS_KINEMATIC
-            block->millimeters
+            plan.millimeters
           #else
-            SQRT(sq(target_float.x - position_float.x)
-               + sq(target_float.y - position_float.y)
-               + sq(target_float.z - position_float.z))
+            (
+              #if ENABLED(ARC_BLOCKS)
+                arc ? plan.millimeters :
+              #endif
+              SQRT(sq(target_float.x - position_float.x)
+                 + sq(target_float.y - position_float.y)
+                 + sq(target_float.z - position_float.z))
+            )
           #endif
         ;
 
         // Check for unusual high e_D ratio to detect if a retract move was combined with the last print move due to min. steps per segment. Never execute this with advance!
         // This assumes no one will use a retract length of 0mm < retr_length < ~0.2mm and no one will print 100mm wide lines using 3mm filament or 35mm wide lines using 1.75mm filament.
-        if (block->e_D_ratio > 3.0f)
+        if (plan.e_D_ratio > 3.0f)
           block->use_advance_lead = false;
         else {
-          const uint32_t max_accel_steps_per_s2 = MAX_E_JERK / (extruder_advance_K[active_extruder] * block->e_D_ratio) * steps_per_mm;
+          const uint32_t max_accel_steps_per_s2 = MAX_E_JERK / (extruder_advance_K[active_extruder] * plan.e_D_ratio) * steps_per_mm;
           #if ENABLED(LA_DEBUG)
             if (accel > max_accel_steps_per_s2) SERIAL_ECHOLNPGM("Acceleration limited.");
           #endif
@@ -2247,18 +2531,25 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     }
   }
   block->acceleration_steps_per_s2 = accel;
-  block->acceleration = accel / steps_per_mm;
+  plan.acceleration = accel / steps_per_mm;
   #if DISABLED(S_CURVE_ACCELERATION)
     block->acceleration_rate = (uint32_t)(accel * (4096.0f * 4096.0f / (STEPPER_TIMER_RATE)));
   #endif
   #if ENABLED(LIN_ADVANCE)
     if (block->use_advance_lead) {
-      block->advance_speed = (STEPPER_TIMER_RATE) / (extruder_advance_K[active_extruder] * block->e_D_ratio * block->acceleration * settings.axis_steps_per_mm[E_AXIS_N(extruder)]);
-      #if ENABLED(LA_DEBUG)
-        if (extruder_advance_K[active_extruder] * block->e_D_ratio * block->acceleration * 2 < SQRT(block->nominal_speed_sqr) * block->e_D_ratio)
-          SERIAL_ECHOLNPGM("More than 2 steps per eISR loop executed.");
-        if (block->advance_speed < 200)
-          SERIAL_ECHOLNPGM("eISR running at > 10kHz.");
+      #if HAS_LA_ISR
+        block->advance_speed = (STEPPER_TIMER_RATE) / (extruder_advance_K[active_extruder] * plan.e_D_ratio * plan.acceleration * settings.axis_steps_per_mm[E_AXIS_N(extruder)]);
+        #if ENABLED(LA_DEBUG)
+          if (extruder_advance_K[active_extruder] * plan.e_D_ratio * plan.acceleration * 2 < SQRT(plan.nominal_speed_sqr) * plan.e_D_ratio)
+            SERIAL_ECHOLNPGM("More than 2 steps per eISR loop executed.");
+          if (block->advance_speed < 200)
+            SERIAL_ECHOLNPGM("eISR running at > 10kHz.");
+        #endif
+      #endif
+      #if EITHER(PLANNER_FIXED_POINT, LA_MERGE_STEPS)
+        // Advance steps per step/s, so the stepper can follow the step rate with one multiply
+        block->adv_steps_per_rate = uint32_t(_MIN(plan.e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS]
+                                                  * 16777216.0f / steps_per_mm + 0.5f, 4294967040.0f));
       #endif
     }
   #endif
@@ -2300,9 +2591,6 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
           can be spared, a better acos could be used. For all I know, it may be
           already calculated in a different place. */
 
-    // Unit vector of previous path line segment
-    static xyze_float_t prev_unit_vec;
-
     xyze_float_t unit_vec =
       #if HAS_DIST_MM_ARG
         cart_dist_mm
@@ -2323,10 +2611,10 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
     // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
     if (moves_queued && !UNEAR_ZERO(previous_nominal_speed_sqr)) {
-      // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
+      // Compute cosine of angle between previous and current path. (previous_unit_vec is negative)
       // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
-      float junction_cos_theta = (-prev_unit_vec.x * unit_vec.x) + (-prev_unit_vec.y * unit_vec.y)
-                               + (-prev_unit_vec.z * unit_vec.z) + (-prev_unit_vec.e * unit_vec.e);
+      float junction_cos_theta = (-previous_unit_vec.x * unit_vec.x) + (-previous_unit_vec.y * unit_vec.y)
+                               + (-previous_unit_vec.z * unit_vec.z) + (-previous_unit_vec.e * unit_vec.e);
 
       // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
       if (junction_cos_theta > 0.999999f) {
@@ -2337,33 +2625,33 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         NOLESS(junction_cos_theta, -0.999999f); // Check for numerical round-off to avoid divide by zero.
 
         // Convert delta vector to unit vector
-        xyze_float_t junction_unit_vec = unit_vec - prev_unit_vec;
+        xyze_float_t junction_unit_vec = unit_vec - previous_unit_vec;
         normalize_junction_vector(junction_unit_vec);
 
-        const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec),
+        const float junction_acceleration = limit_value_by_axis_maximum(plan.acceleration, junction_unit_vec),
                     sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
 
         vmax_junction_sqr = (junction_acceleration * junction_deviation_mm * sin_theta_d2) / (1.0f - sin_theta_d2);
-        if (block->millimeters < 1) {
+        if (plan.millimeters < 1) {
 
           // Fast acos approximation, minus the error bar to be safe
           const float junction_theta = (RADIANS(-40) * sq(junction_cos_theta) - RADIANS(50)) * junction_cos_theta + RADIANS(90) - 0.18f;
 
           // If angle is greater than 135 degrees (octagon), find speed for approximate arc
           if (junction_theta > RADIANS(135)) {
-            const float limit_sqr = block->millimeters / (RADIANS(180) - junction_theta) * junction_acceleration;
+            const float limit_sqr = plan.millimeters / (RADIANS(180) - junction_theta) * junction_acceleration;
             NOMORE(vmax_junction_sqr, limit_sqr);
           }
         }
       }
 
       // Get the lowest speed
-      vmax_junction_sqr = _MIN(vmax_junction_sqr, block->nominal_speed_sqr, previous_nominal_speed_sqr);
+      vmax_junction_sqr = _MIN(vmax_junction_sqr, plan.nominal_speed_sqr, previous_nominal_speed_sqr);
     }
     else // Init entry speed to zero. Assume it starts from rest. Planner will correct this later.
       vmax_junction_sqr = 0;
 
-    prev_unit_vec = unit_vec;
+    previous_unit_vec = unit_vec;
 
   #endif
 
@@ -2381,10 +2669,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
      * Adapted from Průša MKS firmware
      * https://github.com/prusa3d/Prusa-Firmware
      */
-    CACHED_SQRT(nominal_speed, block->nominal_speed_sqr);
-
-    // Exit speed limited by a jerk to full halt of a previous last segment
-    static float previous_safe_speed;
+    CACHED_SQRT(nominal_speed, plan.nominal_speed_sqr);
 
     // Start with a safe speed (from which the machine may halt to stop immediately).
     float safe_speed = nominal_speed;
@@ -2483,14 +2768,31 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   #endif // Classic Jerk Limiting
 
   // Max entry speed of this block equals the max exit speed of the previous block.
-  block->max_entry_speed_sqr = vmax_junction_sqr;
+  plan.max_entry_speed_sqr = SPEED_SQR(vmax_junction_sqr);
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
-  const float v_allowable_sqr = max_allowable_speed_sqr(-block->acceleration, sq(float(MINIMUM_PLANNER_SPEED)), block->millimeters);
+  const float v_allowable_sqr = max_allowable_speed_sqr(-plan.acceleration, sq(float(MINIMUM_PLANNER_SPEED)), plan.millimeters);
 
   // If we are trying to add a split block, start with the
   // max. allowed speed to avoid an interrupted first move.
-  block->entry_speed_sqr = !split_move ? sq(float(MINIMUM_PLANNER_SPEED)) : _MIN(vmax_junction_sqr, v_allowable_sqr);
+  plan.entry_speed_sqr = SPEED_SQR(!split_move ? sq(float(MINIMUM_PLANNER_SPEED)) : _MIN(vmax_junction_sqr, v_allowable_sqr));
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+    // Everything the integer kernels need from the block's float math, worked out once
+    plan.nominal_speed_sqr_fixed = SPEED_SQR(_MIN(plan.nominal_speed_sqr, SPEED_SQR_MAX_FLOAT));
+    plan.accel_speed_sqr = SPEED_SQR(_MIN(2 * plan.acceleration * plan.millimeters, SPEED_SQR_MAX_FLOAT));
+    plan.steps_per_speed_sqr = uint32_t(_MIN(steps_per_mm * float(_BV32(28 - 1 - SPEED_SQR_FRACT_BITS)) / plan.acceleration, 4294967040.0f));
+    plan.rate_per_speed = uint32_t(block->nominal_rate * float(_BV32(16 - SPEED_SQR_FRACT_BITS / 2)) / SQRT(plan.nominal_speed_sqr) + 0.5f);
+    #if ENABLED(S_CURVE_ACCELERATION)
+      plan.timer_per_rate = uint32_t(_MIN(float(STEPPER_TIMER_RATE) * 65536.0f / block->acceleration_steps_per_s2, 4294967040.0f));
+    #endif
+    #if ENABLED(LIN_ADVANCE)
+      if (block->use_advance_lead) {
+        const float comp = plan.e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
+        block->max_adv_steps = SQRT(plan.nominal_speed_sqr) * comp;
+      }
+    #endif
+  #endif
 
   // Initialize planner efficiency flags
   // Set flag if block will always reach maximum junction speed regardless of entry/exit speeds.
@@ -2500,11 +2802,25 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   // block nominal speed limits both the current and next maximum junction speeds. Hence, in both
   // the reverse and forward planners, the corresponding block junction speed will always be at the
   // the maximum junction speed and may always be ignored for any speed reduction checks.
-  block->flag |= block->nominal_speed_sqr <= v_allowable_sqr ? BLOCK_FLAG_RECALCULATE | BLOCK_FLAG_NOMINAL_LENGTH : BLOCK_FLAG_RECALCULATE;
+  block->flag |= plan.nominal_speed_sqr <= v_allowable_sqr ? BLOCK_FLAG_RECALCULATE | BLOCK_FLAG_NOMINAL_LENGTH : BLOCK_FLAG_RECALCULATE;
 
   // Update previous path unit_vector and nominal speed
   previous_speed = current_speed;
-  previous_nominal_speed_sqr = block->nominal_speed_sqr;
+  previous_nominal_speed_sqr = plan.nominal_speed_sqr;
+
+  #if ENABLED(ARC_BLOCKS)
+    if (arc) {
+      // The next block joins the arc where it ends
+      const float xy_speed = HYPOT(current_speed.x, current_speed.y);
+      previous_speed.x = arc_end_dir.x * xy_speed;
+      previous_speed.y = arc_end_dir.y * xy_speed;
+      #if DISABLED(CLASSIC_JERK)
+        const float xy_unit = HYPOT(previous_unit_vec.x, previous_unit_vec.y);
+        previous_unit_vec.x = arc_end_dir.x * xy_unit;
+        previous_unit_vec.y = arc_end_dir.y * xy_unit;
+      #endif
+    }
+  #endif
 
   // Update the position
   position = target;
@@ -2517,7 +2833,11 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   #endif
 
   #if ENABLED(POWER_LOSS_RECOVERY)
-    block->sdpos = recovery.command_sdpos();
+    plan.sdpos =
+      #if ENABLED(COALESCE_SEGMENTS)
+        coalesce.fusing ? coalesce.sdpos : // A fused block resumes from its first command
+      #endif
+      recovery.command_sdpos();
   #endif
 
   // Movement was accepted
@@ -2530,11 +2850,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
  */
 void Planner::buffer_sync_block() {
   // Wait for the next available block
-  uint8_t next_buffer_head;
+  block_index_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
   // Clear block
   memset(block, 0, sizeof(block_t));
+  memset(&block_plan[block_buffer_head], 0, sizeof(block_plan_t));
 
   block->flag = BLOCK_FLAG_SYNC_POSITION;
 
@@ -2566,12 +2887,16 @@ void Planner::buffer_sync_block() {
  *  fr_mm_s     - (target) speed of the move
  *  extruder    - target extruder
  *  millimeters - the length of the movement, if known
+ *  arc         - the arc to follow in X and Y, if any
  */
 bool Planner::buffer_segment(const float &a, const float &b, const float &c, const float &e
   #if HAS_DIST_MM_ARG
     , const xyze_float_t &cart_dist_mm
   #endif
   , const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters/*=0.0*/
+  #if ENABLED(ARC_BLOCKS)
+    , const arc_t * const arc/*=nullptr*/
+  #endif
 ) {
 
   // If we are cleaning, do not accept queuing of movements
@@ -2641,23 +2966,149 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
     SERIAL_ECHOLNPGM(")");
   //*/
 
+  #if ENABLED(COALESCE_SEGMENTS)
+    // If this segment continues the newest block, take the block back and queue both as one
+    const xyze_pos_t target_mm = { a, b, c, e };
+    coalesce_t state;
+    coalesce.fusing = !millimeters && take_back_last_block(target_mm, fr_mm_s, extruder);
+    if (coalesce.fusing) state = coalesce; else save_coalesce_state(state);
+    const block_index_t index = block_buffer_head;
+  #endif
+
   // Queue the movement
-  if (
-    !_buffer_steps(target
-      #if HAS_POSITION_FLOAT
-        , target_float
-      #endif
-      #if HAS_DIST_MM_ARG
-        , cart_dist_mm
+  const bool queued = _buffer_steps(target
+    #if HAS_POSITION_FLOAT
+      , target_float
+    #endif
+    #if HAS_DIST_MM_ARG
+      , cart_dist_mm
+    #endif
+    , fr_mm_s, extruder, millimeters
+    #if ENABLED(ARC_BLOCKS)
+      , arc
+    #endif
+  );
+
+  #if ENABLED(COALESCE_SEGMENTS)
+    // Remember how to take back the new block, unless it was too short to be queued
+    coalesce.fusing = false;
+    if (block_buffer_head != index) {
+      state.index = index;
+      state.end = position;
+      state.end_mm = target_mm;
+      state.fr_mm_s = fr_mm_s;
+      state.extruder = extruder;
+      state.fusing = false;
+      #if ENABLED(POWER_LOSS_RECOVERY)
+        state.sdpos = block_plan[index].sdpos;
       #endif
-      , fr_mm_s, extruder, millimeters
-    )
-  ) return false;
+      coalesce = state;
+    }
+  #endif
+
+  if (!queued) return false;
 
   stepper.wake_up();
   return true;
 } // buffer_segment()
 
+#if ENABLED(COALESCE_SEGMENTS)
+
+  void Planner::save_coalesce_state(coalesce_t &state) {
+    // Segments are measured between requested positions, so a chain of them
+    // isn't bent by rounding to steps. Fall back on steps after a position change.
+    bool follows = true;
+    LOOP_XYZE(i) if (position[i] != coalesce.end[i]) follows = false;
+    if (follows)
+      state.start_mm = coalesce.end_mm;
+    else
+      LOOP_XYZE(i) state.start_mm[i] = position[i] * steps_to_mm[i];
+    state.start = position;
+    #if HAS_POSITION_FLOAT
+      state.start_float = position_float;
+    #endif
+    state.previous_speed = previous_speed;
+    state.previous_nominal_speed_sqr = previous_nominal_speed_sqr;
+    #if DISABLED(CLASSIC_JERK)
+      state.previous_unit_vec = previous_unit_vec;
+    #endif
+    #if HAS_CLASSIC_JERK
+      state.previous_safe_speed = previous_safe_speed;
+    #endif
+  }
+
+  /**
+   * Take the newest block back out of the buffer and restore the planner
+   * state from before it, if a segment to the given target continues it
+   * closely enough to be queued together as one block:
+   *
+   *  - Same feedrate and extruder, and the block is still waiting
+   *  - Heading within COALESCE_DEVIATION_MM: for a chord of an arc the
+   *    estimate (L1 + L2) * sin(turn) / 4 is the sagitta of the fused chord
+   *  - Extrusion per mm within COALESCE_E_RATIO of the block's
+   */
+  bool Planner::take_back_last_block(const xyze_pos_t &target_mm, const feedRate_t &fr_mm_s, const uint8_t extruder) {
+    const block_index_t index = coalesce.index;
+    if (fr_mm_s != coalesce.fr_mm_s || extruder != coalesce.extruder) return false;
+    // The Stepper ISR may be taking the block that is next in line, so leave that alone
+    if (block_buffer_head != next_block_index(index) || index == block_buffer_tail || index == block_buffer_nonbusy) return false;
+    LOOP_XYZE(i) if (position[i] != coalesce.end[i]) return false;
+
+    block_t * const last = &block_buffer[index];
+    if (TEST(last->flag, BLOCK_BIT_SYNC_POSITION)
+      #if ENABLED(ARC_BLOCKS)
+        || last->arc_chords
+      #endif
+    ) return false;
+
+    const xyze_float_t d1 = coalesce.end_mm - coalesce.start_mm, d2 = target_mm - coalesce.end_mm;
+    const float l1 = SQRT(sq(d1.x) + sq(d1.y) + sq(d1.z)), l2 = SQRT(sq(d2.x) + sq(d2.y) + sq(d2.z));
+    if (!l1 || !l2 || l1 + l2 > COALESCE_MAX_MM || d1.x * d2.x + d1.y * d2.y + d1.z * d2.z <= 0) return false;
+
+    const xyz_float_t turn = { d1.y * d2.z - d1.z * d2.y, d1.z * d2.x - d1.x * d2.z, d1.x * d2.y - d1.y * d2.x };
+    if ((l1 + l2) * turn.magnitude() > 4 * (COALESCE_DEVIATION_MM) * l1 * l2) return false;
+
+    const float e1 = d1.e / l1, e2 = d2.e / l2;
+    if ((e1 < 0) != (e2 < 0) || ABS(e1 - e2) > (COALESCE_E_RATIO) * _MAX(ABS(e1), ABS(e2))) return false;
+
+    // Keep the Stepper ISR off the block, unless it just took it
+    SBI(last->flag, BLOCK_BIT_RECALCULATE);
+    if (stepper.is_block_busy(last)) {
+      CBI(last->flag, BLOCK_BIT_RECALCULATE);
+      return false;
+    }
+
+    #if HAS_BLOCK_RUNTIME
+      const bool was_enabled = stepper.suspend();
+      block_buffer_runtime_us -= block_plan[index].segment_time_us;
+      if (was_enabled) stepper.wake_up();
+    #endif
+
+    position = coalesce.start;
+    #if HAS_POSITION_FLOAT
+      position_float = coalesce.start_float;
+    #endif
+    previous_speed = coalesce.previous_speed;
+    previous_nominal_speed_sqr = coalesce.previous_nominal_speed_sqr;
+    #if DISABLED(CLASSIC_JERK)
+      previous_unit_vec = coalesce.previous_unit_vec;
+    #endif
+    #if HAS_CLASSIC_JERK
+      previous_safe_speed = coalesce.previous_safe_speed;
+    #endif
+
+    // The planned pointer may only stop short of the head
+    if (block_buffer_planned == block_buffer_head) block_buffer_planned = index;
+    block_buffer_head = index;
+
+    #ifdef HAL_BENCHMARK
+      HAL_BENCH_COUNT(coalesced);
+    #endif
+    return true;
+  }
+
+#endif // COALESCE_SEGMENTS
+
 /**
  * Add a new linear movement to the buffer.
  * The target is cartesian. It's translated to
@@ -2722,6 +3173,48 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
   #endif
 } // buffer_line()
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Add an arc in the XY plane to the buffer, as one block
+   *
+   *  cart        - target position in mm
+   *  arc         - the arc from the current position to the target
+   *  fr_mm_s     - (target) speed of the move (mm/s)
+   *  extruder    - target extruder
+   *  millimeters - the length of the arc
+   */
+  bool Planner::buffer_arc(const xyze_pos_t &cart, const arc_t &arc, const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters) {
+    #if ENABLED(BACKLASH_COMPENSATION)
+      // Backlash is taken up where a block reverses, not within one
+      if (backlash.correction) return false;
+    #endif
+
+    // The sine of the turn, scaled between X and Y steps, must fit its fixed point
+    const float ratio = settings.axis_steps_per_mm[X_AXIS] / settings.axis_steps_per_mm[Y_AXIS];
+    if (ABS(sin(arc.angle)) * _MAX(ratio, 1.0f / ratio) >= 7.9f) return false;
+
+    xyze_pos_t machine = cart;
+    #if HAS_POSITION_MODIFIERS
+      apply_modifiers(machine);
+    #endif
+
+    #if ENABLED(SKEW_CORRECTION)
+      // XY skew would make the circle an ellipse, and XZ or YZ skew lean a helix.
+      // On one layer XZ and YZ skew just move the arc, as they do the target.
+      if (skew_factor.xy || ((skew_factor.xz || skew_factor.yz) && LROUND(machine.z * settings.axis_steps_per_mm[Z_AXIS]) != position.z))
+        return false;
+    #endif
+
+    arc_t moved = arc;
+    moved.center.x += machine.x - cart.x;
+    moved.center.y += machine.y - cart.y;
+    buffer_segment(machine.x, machine.y, machine.z, machine.e, fr_mm_s, extruder, millimeters, &moved);
+    return true;
+  }
+
+#endif
+
 /**
  * Directly set the planner ABC position (and stepper positions)
  * converting mm (or angles for SCARA) into steps.
@@ -2882,7 +3375,7 @@ void Planner::set_max_jerk(const AxisEnum axis, float targetValue) {
   #endif
 }
 
-#if HAS_SPI_LCD
+#if HAS_BLOCK_RUNTIME
 
   uint16_t Planner::block_buffer_runtime() {
     #ifdef __AVR__
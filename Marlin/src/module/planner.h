@@ -65,6 +65,44 @@
   #define HAS_DIST_MM_ARG 1
 #endif
 
+/**
+ * Junction and entry speeds squared, as the planner kernels see them.
+ * With PLANNER_FIXED_POINT these are unsigned 24.8 fixed point (mm/s)^2,
+ * saturating at SPEED_SQR_MAX (about 4096 mm/s).
+ */
+#if ENABLED(PLANNER_FIXED_POINT)
+  typedef uint32_t speed_sqr_t;
+  #define SPEED_SQR_FRACT_BITS  8
+  #define SPEED_SQR_MAX         0xFFFFFFFFUL
+  #define SPEED_SQR_MAX_FLOAT   16777215.0f   // The largest float that converts without overflow
+  #define SPEED_SQR(F)          speed_sqr_t((F) * float(_BV32(SPEED_SQR_FRACT_BITS)) + 0.5f)
+  #define SPEED_SQR_TO_FLOAT(V) (float(V) * (1.0f / _BV32(SPEED_SQR_FRACT_BITS)))
+#else
+  typedef float speed_sqr_t;
+  #define SPEED_SQR(F)          (F)
+  #define SPEED_SQR_TO_FLOAT(V) (V)
+#endif
+
+#if ENABLED(ARC_BLOCKS)
+  /**
+   * Arc blocks keep the radius vector in 24.8 fixed point steps and
+   * the rotation from one chord to the next in 4.28 fixed point.
+   */
+  #define ARC_RADIUS_FRACT_BITS 8
+  #define ARC_ROTATE_FRACT_BITS 28
+
+  /**
+   * An arc in the XY plane, for Planner::buffer_arc. The target of the
+   * block is the end of the arc. The start is the planner position.
+   */
+  typedef struct {
+    xy_pos_t center;    // Machine position of the center (mm)
+    float radius,       // (mm)
+          angle;        // Turn from one chord to the next, counter-clockwise positive (radians)
+    uint16_t chords;
+  } arc_t;
+#endif
+
 enum BlockFlagBit : char {
   // Recalculate trapezoids on entry junction. For optimization.
   BLOCK_BIT_RECALCULATE,
@@ -94,25 +132,15 @@ enum BlockFlag : char {
  * A single entry in the planner buffer.
  * Tracks linear movement over multiple axes.
  *
- * The "nominal" values are as-specified by gcode, and
- * may never actually be reached due to acceleration limits.
+ * Only what the Stepper ISR reads is kept here. The look-ahead data
+ * and the rarely used feature fields are in block_plan_t, at the same
+ * index in Planner::block_plan[].
  */
 typedef struct block_t {
 
   volatile uint8_t flag;                    // Block flags (See BlockFlag enum above) - Modified by ISR and main thread!
 
-  // Fields used by the motion planner to manage acceleration
-  float nominal_speed_sqr,                  // The nominal speed for this block in (mm/sec)^2
-        entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
-        max_entry_speed_sqr,                // Maximum allowable junction entry speed in (mm/sec)^2
-        millimeters,                        // The total travel of this block in mm
-        acceleration;                       // acceleration mm/sec^2
-
-  union {
-    abce_ulong_t steps;                     // Step count along each axis
-    abce_long_t position;                   // New position to force when this sync block is executed
-  };
-  uint32_t step_event_count;                // The number of step events required to complete this block
+  uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
 
   #if EXTRUDERS > 1
     uint8_t extruder;                       // The extruder to move (if E move)
@@ -120,10 +148,31 @@ typedef struct block_t {
     static constexpr uint8_t extruder = 0;
   #endif
 
+  #if ENABLED(LIN_ADVANCE)
+    bool use_advance_lead;
+  #endif
+
   #if ENABLED(MIXING_EXTRUDER)
     MIXER_BLOCK_FIELD;                      // Normalized color for the mixing steppers
   #endif
 
+  union {
+    abce_ulong_t steps;                     // Step count along each axis
+    abce_long_t position;                   // New position to force when this sync block is executed
+  };
+  uint32_t step_event_count;                // The number of step events required to complete this block
+
+  #if ENABLED(ARC_BLOCKS)
+    // X and Y follow the chords of an arc, with the same number of events in each
+    uint16_t arc_chords;                    // Chords of the arc, or 0 for a line
+    uint32_t arc_chord_events;              // Step events in each chord
+    xy_long_t arc_center,                   // Center in steps (ARC_RADIUS_FRACT_BITS)
+              arc_radius,                   // Start position minus the center (ARC_RADIUS_FRACT_BITS)
+              arc_end;                      // End position in steps
+    int32_t arc_cos,                        // Rotation per chord (ARC_ROTATE_FRACT_BITS), with the
+            arc_sin_x, arc_sin_y;           // sine scaled to X and Y steps/mm
+  #endif
+
   // Settings for the trapezoid generator
   uint32_t accelerate_until,                // The index of the step event on which to stop acceleration
            decelerate_after;                // The index of the step event on which to start decelerating
@@ -138,15 +187,16 @@ typedef struct block_t {
     uint32_t acceleration_rate;             // The acceleration rate used for acceleration calculation
   #endif
 
-  uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
-
   // Advance extrusion
   #if ENABLED(LIN_ADVANCE)
-    bool use_advance_lead;
-    uint16_t advance_speed,                 // STEP timer value for extruder speed offset ISR
-             max_adv_steps,                 // max. advance steps to get cruising speed pressure (not always nominal_speed!)
+    #if HAS_LA_ISR
+      uint16_t advance_speed;               // STEP timer value for extruder speed offset ISR
+    #endif
+    uint16_t max_adv_steps,                 // max. advance steps to get cruising speed pressure (not always nominal_speed!)
              final_adv_steps;               // advance steps due to exit speed
-    float e_D_ratio;
+    #if EITHER(PLANNER_FIXED_POINT, LA_MERGE_STEPS)
+      uint32_t adv_steps_per_rate;          // Advance steps per step/s of the block (8.24 fixed point)
+    #endif
   #endif
 
   uint32_t nominal_rate,                    // The nominal step rate for this block in step_events/sec
@@ -158,15 +208,44 @@ typedef struct block_t {
     cutter_power_t cutter_power;            // Power level for Spindle, Laser, etc.
   #endif
 
-  #if FAN_COUNT > 0
-    uint8_t fan_speed[FAN_COUNT];
+} block_t;
+
+/**
+ * struct block_plan_t
+ *
+ * The planner's side of a block: the speeds and limits the look-ahead
+ * works on, the constants of the fixed-point kernels, and the feature
+ * values applied when the block comes up. The Stepper ISR never reads
+ * these, except the SD position once per block.
+ *
+ * The "nominal" values are as-specified by gcode, and
+ * may never actually be reached due to acceleration limits.
+ */
+typedef struct {
+
+  // Fields used by the motion planner to manage acceleration
+  float nominal_speed_sqr;                  // The nominal speed for this block in (mm/sec)^2
+  speed_sqr_t entry_speed_sqr,              // Entry speed at previous-current junction in (mm/sec)^2
+              max_entry_speed_sqr;          // Maximum allowable junction entry speed in (mm/sec)^2
+  float millimeters,                        // The total travel of this block in mm
+        acceleration;                       // acceleration mm/sec^2
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+    // Constants of the block for the integer kernels, set once when it is queued
+    speed_sqr_t nominal_speed_sqr_fixed,    // nominal_speed_sqr as a speed_sqr_t
+                accel_speed_sqr;            // Change of speed squared over the whole block at full acceleration
+    uint32_t steps_per_speed_sqr,           // Steps to change speed squared by one speed_sqr_t unit (4.28 fixed point)
+             rate_per_speed;                // Step rate per unit of sqrt(speed_sqr_t) (16.16 fixed point)
+    #if ENABLED(S_CURVE_ACCELERATION)
+      uint32_t timer_per_rate;              // STEP timer ticks to change the step rate by 1 step/s (16.16 fixed point)
+    #endif
   #endif
 
-  #if ENABLED(BARICUDA)
-    uint8_t valve_pressure, e_to_p_pressure;
+  #if ENABLED(LIN_ADVANCE)
+    float e_D_ratio;
   #endif
 
-  #if HAS_SPI_LCD
+  #if HAS_BLOCK_RUNTIME
     uint32_t segment_time_us;
   #endif
 
@@ -174,12 +253,23 @@ typedef struct block_t {
     uint32_t sdpos;
   #endif
 
-} block_t;
+  #if FAN_COUNT > 0
+    uint8_t fan_speed[FAN_COUNT];
+  #endif
+
+  #if ENABLED(BARICUDA)
+    uint8_t valve_pressure, e_to_p_pressure;
+  #endif
+
+} block_plan_t;
 
 #define HAS_POSITION_FLOAT ANY(LIN_ADVANCE, SCARA_FEEDRATE_SCALING, GRADIENT_MIX, LCD_SHOW_E_TOTAL)
 
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
+// Index into the block ring, 16 bits for the deep buffers of 32-bit and Linux targets
+typedef IF<(BLOCK_BUFFER_SIZE > 128), uint16_t, uint8_t>::type block_index_t;
+
 typedef struct {
    uint32_t max_acceleration_mm_per_s2[XYZE_N], // (mm/s^2) M201 XYZE
             min_segment_time_us;                // (µs) M205 B
@@ -229,13 +319,30 @@ class Planner {
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
-    static volatile uint8_t block_buffer_head,      // Index of the next block to be pushed
-                            block_buffer_nonbusy,   // Index of the first non busy block
-                            block_buffer_planned,   // Index of the optimally planned block
-                            block_buffer_tail;      // Index of the busy block, if any
+    static block_plan_t block_plan[BLOCK_BUFFER_SIZE];    // The planner's side of each block, by the same index
+    static volatile block_index_t block_buffer_head,      // Index of the next block to be pushed
+                                  block_buffer_nonbusy,   // Index of the first non busy block
+                                  block_buffer_planned,   // Index of the optimally planned block
+                                  block_buffer_tail;      // Index of the busy block, if any
     static uint16_t cleaning_buffer_counter;        // A counter to disable queuing of blocks
     static uint8_t delay_before_delivering;         // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
+    #if ENABLED(PLANNER_STATS)
+      /**
+       * Counts for M123, to tell a starved planner from a slow one
+       */
+      #define PLANNER_STATS_BINS _MIN(8, BLOCK_BUFFER_SIZE)
+      typedef struct {
+        uint32_t depth[PLANNER_STATS_BINS];   // Blocks taken by the Stepper ISR, by movesplanned() at the time
+        uint32_t recalculations,              // Calls to recalculate() and their time in µs
+                 recalculate_us,
+                 recalculate_max_us,
+                 reverse_passes,              // Reverse passes, and those cut short by an unchanged entry speed
+                 short_reverse_passes;
+      } planner_stats_t;
+      static planner_stats_t stats;
+    #endif
+
 
     #if ENABLED(DISTINCT_E_FACTORS)
       static uint8_t last_extruder;                 // Respond to extruder change
@@ -325,6 +432,54 @@ class Planner {
      */
     static float previous_nominal_speed_sqr;
 
+    #if DISABLED(CLASSIC_JERK)
+      /**
+       * Unit vector of previous path line segment
+       */
+      static xyze_float_t previous_unit_vec;
+    #endif
+
+    #if HAS_CLASSIC_JERK
+      /**
+       * Exit speed limited by a jerk to full halt of the previous path line segment
+       */
+      static float previous_safe_speed;
+    #endif
+
+    #if ENABLED(COALESCE_SEGMENTS)
+      /**
+       * Planner state from before the newest block was added, so the block
+       * can be taken back out and fused with the next segment
+       */
+      typedef struct {
+        block_index_t index;              // Buffer index of the block
+        xyze_long_t start, end;           // Step positions before and after it
+        xyze_pos_t start_mm, end_mm;      // The same as requested, before rounding to steps
+        #if HAS_POSITION_FLOAT
+          xyze_pos_t start_float;
+        #endif
+        xyze_float_t previous_speed;
+        float previous_nominal_speed_sqr;
+        #if DISABLED(CLASSIC_JERK)
+          xyze_float_t previous_unit_vec;
+        #endif
+        #if HAS_CLASSIC_JERK
+          float previous_safe_speed;
+        #endif
+        #if ENABLED(POWER_LOSS_RECOVERY)
+          uint32_t sdpos;                 // Of the first command in the block
+        #endif
+        feedRate_t fr_mm_s;
+        uint8_t extruder;
+        bool fusing;                      // The block being filled replaces the newest one
+      } coalesce_t;
+
+      static coalesce_t coalesce;
+
+      static void save_coalesce_state(coalesce_t &state);
+      static bool take_back_last_block(const xyze_pos_t &target_mm, const feedRate_t &fr_mm_s, const uint8_t extruder);
+    #endif
+
     /**
      * Limit where 64bit math is necessary for acceleration calculation
      */
@@ -336,9 +491,10 @@ class Planner {
 
     #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
       /**
-       * Counters to manage disabling inactive extruders
+       * Counters to manage disabling inactive extruders, up to twice the buffer size
        */
-      static uint8_t g_uc_extruder_last_move[EXTRUDERS];
+      typedef IF<((BLOCK_BUFFER_SIZE) * 2 > 255), uint16_t, uint8_t>::type last_move_t;
+      static last_move_t g_uc_extruder_last_move[EXTRUDERS];
     #endif // DISABLE_INACTIVE_EXTRUDER
 
     #ifdef XY_FREQUENCY_LIMIT
@@ -350,7 +506,7 @@ class Planner {
       static xy_ulong_t axis_segment_time_us[3];
     #endif
 
-    #if HAS_SPI_LCD
+    #if HAS_BLOCK_RUNTIME
       volatile static uint32_t block_buffer_runtime_us; //Theoretical block buffer runtime in µs
     #endif
 
@@ -545,10 +701,10 @@ class Planner {
     #endif // HAS_POSITION_MODIFIERS
 
     // Number of moves currently in the planner including the busy block, if any
-    FORCE_INLINE static uint8_t movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_tail); }
+    FORCE_INLINE static block_index_t movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_tail); }
 
     // Number of nonbusy moves currently in the planner
-    FORCE_INLINE static uint8_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
+    FORCE_INLINE static block_index_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
 
     // Remove all blocks from the buffer
     FORCE_INLINE static void clear_block_buffer() { block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail = 0; }
@@ -557,20 +713,29 @@ class Planner {
     FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
 
     // Get count of movement slots free
-    FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
+    FORCE_INLINE static block_index_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - movesplanned(); }
+
+    // The planner's side of a block in the buffer
+    FORCE_INLINE static block_plan_t& plan_of(const block_t * const block) { return block_plan[block - block_buffer]; }
 
     /**
      * Planner::get_next_free_block
      *
      * - Get the next head indices (passed by reference)
      * - Wait for the number of spaces to open up in the planner
+     * - Wait for the queued moves to drop below the lookahead horizon
      * - Return the first head block
      */
-    FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
+    FORCE_INLINE static block_t* get_next_free_block(block_index_t &next_buffer_head, const uint8_t count=1) {
 
       // Wait until there are enough slots free
       while (moves_free() < count) { idle(); }
 
+      #ifdef PLANNER_HORIZON_MS
+        // Keep at least two blocks to plan a junction, however long they are
+        while (block_buffer_runtime_us > (PLANNER_HORIZON_MS) * 1000UL && nonbusy_movesplanned() > 1) { idle(); }
+      #endif
+
       // Return the first available block
       next_buffer_head = next_block_index(block_buffer_head);
       return &block_buffer[block_buffer_head];
@@ -585,6 +750,7 @@ class Planner {
      *  fr_mm_s     - (target) speed of the move
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
+     *  arc         - the arc to follow in X and Y, if any
      *
      * Returns true if movement was buffered, false otherwise
      */
@@ -596,6 +762,9 @@ class Planner {
         , const xyze_float_t &cart_dist_mm
       #endif
       , feedRate_t fr_mm_s, const uint8_t extruder, const float &millimeters=0.0
+      #if ENABLED(ARC_BLOCKS)
+        , const arc_t * const arc=nullptr
+      #endif
     );
 
     /**
@@ -607,6 +776,7 @@ class Planner {
      *  fr_mm_s     - (target) speed of the move
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
+     *  arc         - the arc to follow in X and Y, if any
      *
      * Returns true is movement is acceptable, false otherwise
      */
@@ -619,6 +789,9 @@ class Planner {
         , const xyze_float_t &cart_dist_mm
       #endif
       , feedRate_t fr_mm_s, const uint8_t extruder, const float &millimeters=0.0
+      #if ENABLED(ARC_BLOCKS)
+        , const arc_t * const arc=nullptr
+      #endif
     );
 
     /**
@@ -645,12 +818,16 @@ class Planner {
      *  fr_mm_s     - (target) speed of the move
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
+     *  arc         - the arc to follow in X and Y, if any
      */
     static bool buffer_segment(const float &a, const float &b, const float &c, const float &e
       #if HAS_DIST_MM_ARG
         , const xyze_float_t &cart_dist_mm
       #endif
       , const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters=0.0
+      #if ENABLED(ARC_BLOCKS)
+        , const arc_t * const arc=nullptr
+      #endif
     );
 
     FORCE_INLINE static bool buffer_segment(abce_pos_t &abce
@@ -697,6 +874,24 @@ class Planner {
       );
     }
 
+    #if ENABLED(ARC_BLOCKS)
+      /**
+       * Add an arc in the XY plane to the buffer, as one block.
+       * Z and E move linearly along it. The target is cartesian.
+       * Leveling must be off.
+       *
+       *  cart        - target position in mm
+       *  arc         - the arc from the current position to the target
+       *  fr_mm_s     - (target) speed of the move (mm/s)
+       *  extruder    - target extruder
+       *  millimeters - the length of the arc
+       *
+       * Returns false if the arc can't be stepped as one block, so
+       * it should be queued as lines instead
+       */
+      static bool buffer_arc(const xyze_pos_t &cart, const arc_t &arc, const feedRate_t &fr_mm_s, const uint8_t extruder, const float &millimeters);
+    #endif
+
     /**
      * Set the planner.position and individual stepper positions.
      * Used by G92, G28, G29, and other procedures.
@@ -795,7 +990,7 @@ class Planner {
         block_buffer_tail = next_block_index(block_buffer_tail);
     }
 
-    #if HAS_SPI_LCD
+    #if HAS_BLOCK_RUNTIME
       static uint16_t block_buffer_runtime();
       static void clear_block_buffer_runtime();
     #endif
@@ -824,8 +1019,8 @@ class Planner {
     /**
      * Get the index of the next / previous block in the ring buffer
      */
-    static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
-    static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    static constexpr block_index_t next_block_index(const block_index_t block_index) { return BLOCK_MOD(block_index + 1); }
+    static constexpr block_index_t prev_block_index(const block_index_t block_index) { return BLOCK_MOD(block_index - 1); }
 
     /**
      * Calculate the distance (not time) it takes to accelerate
@@ -858,6 +1053,50 @@ class Planner {
       return target_velocity_sqr - 2 * accel * distance;
     }
 
+    /**
+     * The same over a whole block using its full acceleration, as the planner kernels use it
+     */
+    FORCE_INLINE static speed_sqr_t max_allowable_speed_sqr(const block_plan_t &plan, const speed_sqr_t &target_velocity_sqr) {
+      #if ENABLED(PLANNER_FIXED_POINT)
+        return target_velocity_sqr < SPEED_SQR_MAX - plan.accel_speed_sqr ? target_velocity_sqr + plan.accel_speed_sqr : SPEED_SQR_MAX;
+      #else
+        return max_allowable_speed_sqr(-plan.acceleration, target_velocity_sqr, plan.millimeters);
+      #endif
+    }
+
+    #if ENABLED(PLANNER_FIXED_POINT)
+
+      /**
+       * Step rate at a speed squared, rounded up, for the block's rate_per_speed.
+       * The integer square root is taken with up to 8 extra fraction bits, so
+       * slow junctions keep their precision.
+       */
+      static uint32_t rate_for_speed_sqr(const block_plan_t &plan, speed_sqr_t speed_sqr) {
+        uint8_t fract = 16;
+        for (; fract < 24 && speed_sqr < _BV32(30); fract++) speed_sqr <<= 2;
+        uint32_t root = 0;
+        for (uint32_t bit = _BV32(30); bit; bit >>= 2) {
+          if (speed_sqr >= root + bit) {
+            speed_sqr -= root + bit;
+            root = (root >> 1) + bit;
+          }
+          else
+            root >>= 1;
+        }
+        return uint32_t((uint64_t(root) * plan.rate_per_speed + _BV32(fract) - 1) >> fract);
+      }
+
+      /**
+       * Steps taken while changing speed squared by the given amount
+       */
+      FORCE_INLINE static uint32_t steps_for_speed_sqr(const block_plan_t &plan, const speed_sqr_t delta, const bool round_up) {
+        return uint32_t((uint64_t(delta) * plan.steps_per_speed_sqr + (round_up ? _BV32(28) - 1 : 0)) >> 28);
+      }
+
+      static void calculate_trapezoid_for_block(block_t* const block, const speed_sqr_t entry_speed_sqr, const speed_sqr_t exit_speed_sqr);
+
+    #endif
+
     #if ENABLED(S_CURVE_ACCELERATION)
       /**
        * Calculate the speed reached given initial speed, acceleration and distance
@@ -870,12 +1109,12 @@ class Planner {
     static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
 
     static void reverse_pass_kernel(block_t* const current, const block_t * const next);
-    static void forward_pass_kernel(const block_t * const previous, block_t* const current, uint8_t block_index);
+    static void forward_pass_kernel(const block_t * const previous, block_t* const current, block_index_t block_index);
 
     static void reverse_pass();
     static void forward_pass();
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const block_index_t planned_block_index);
 
     static void recalculate();
 
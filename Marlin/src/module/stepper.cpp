@@ -133,6 +133,12 @@ Stepper stepper; // Singleton
   #include "../feature/powerloss.h"
 #endif
 
+#if ENABLED(STEPPER_ISR_PROFILE)
+  #include "../feature/stepper_profile.h"
+#else
+  #define STEPPER_PROFILE(P) NOOP
+#endif
+
 // public:
 
 #if HAS_EXTRA_ENDSTOPS || ENABLED(Z_STEPPER_AUTO_ALIGN)
@@ -143,6 +149,10 @@ Stepper stepper; // Singleton
   uint32_t Stepper::motor_current_setting[3]; // Initialized by settings.load()
 #endif
 
+#if ENABLED(PLANNER_STATS)
+  uint32_t Stepper::starved, Stepper::starved_waiting; // = 0
+#endif
+
 // private:
 
 block_t* Stepper::current_block; // (= nullptr) A pointer to the block currently being traced
@@ -211,14 +221,20 @@ uint32_t Stepper::advance_divisor = 0,
 
 #if ENABLED(LIN_ADVANCE)
 
-  uint32_t Stepper::nextAdvanceISR = LA_ADV_NEVER,
-           Stepper::LA_isr_rate = LA_ADV_NEVER;
+  #if HAS_LA_ISR
+    uint32_t Stepper::nextAdvanceISR = LA_ADV_NEVER,
+             Stepper::LA_isr_rate = LA_ADV_NEVER;
+    int8_t   Stepper::LA_steps = 0;
+  #else
+    uint32_t Stepper::LA_adv_steps_per_rate;
+    int16_t  Stepper::LA_steps = 0;
+    bool     Stepper::LA_reverse; // = false
+  #endif
+
   uint16_t Stepper::LA_current_adv_steps = 0,
            Stepper::LA_final_adv_steps,
            Stepper::LA_max_adv_steps;
 
-  int8_t   Stepper::LA_steps = 0;
-
   bool Stepper::LA_use_advance_lead;
 
 #endif // LIN_ADVANCE
@@ -227,6 +243,35 @@ uint32_t Stepper::advance_divisor = 0,
   uint32_t Stepper::nextBabystepISR = BABYSTEP_NEVER;
 #endif
 
+#if ENABLED(INPUT_SHAPING)
+  uint32_t Stepper::nextShapingISR = SHAPING_NEVER,
+           Stepper::shaping_clock = 0;
+  shaping_axis_t Stepper::shaping_x, Stepper::shaping_y;
+#endif
+
+#if ENABLED(STEP_SCHEDULE)
+  step_schedule_t Stepper::schedule[BLOCK_BUFFER_SIZE];
+  const uint32_t *Stepper::schedule_next;
+  uint32_t Stepper::schedule_skip = 0;
+  uint16_t Stepper::schedule_accel = 0,
+           Stepper::schedule_decel = 0;
+  uint32_t Stepper::schedule_nominal = 0;
+#endif
+
+#if ENABLED(STEP_STREAM)
+  hal_timer_t Stepper::stream_clock = 0,
+              Stepper::stream_last = 0;
+  uint8_t Stepper::stream_last_dir = 0,
+          Stepper::stream_dir = 0xFF,
+          Stepper::stream_extruder = 0;
+#endif
+
+#if ENABLED(ARC_BLOCKS)
+  uint16_t Stepper::arc_chords_left = 0;
+  uint32_t Stepper::arc_events_left = 0;
+  xy_long_t Stepper::arc_radius, Stepper::arc_vertex;
+#endif
+
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(S_CURVE_ACCELERATION)
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
@@ -429,6 +474,17 @@ constexpr uint32_t NS_TO_PULSE_TIMER_TICKS(uint32_t NS) { return (NS + (NS_PER_P
   #define DIR_WAIT_AFTER()
 #endif
 
+#if ENABLED(LIN_ADVANCE)
+  // Set the E DIR pins for the LA_steps to come
+  #if ENABLED(MIXING_EXTRUDER)
+    // We don't know which steppers will be stepped because LA loop follows,
+    // with potentially multiple steps. Set all.
+    #define LA_E_DIR(REV) do{ if (REV) MIXER_STEPPER_LOOP(j) REV_E_DIR(j); else MIXER_STEPPER_LOOP(j) NORM_E_DIR(j); }while(0)
+  #else
+    #define LA_E_DIR(REV) do{ if (REV) REV_E_DIR(stepper_extruder); else NORM_E_DIR(stepper_extruder); }while(0)
+  #endif
+#endif
+
 /**
  * Set the stepper direction of each axis
  *
@@ -438,16 +494,32 @@ constexpr uint32_t NS_TO_PULSE_TIMER_TICKS(uint32_t NS) { return (NS + (NS_PER_P
  */
 void Stepper::set_directions() {
 
+  #if ENABLED(STEP_STREAM)
+    // stream_output() sets the DIR pins as the frames are played
+    LOOP_XYZE(i) count_direction[i] = motor_direction(AxisEnum(i)) ? -1 : 1;
+    return;
+  #endif
+
   DIR_WAIT_BEFORE();
 
-  #define SET_STEP_DIR(A)                       \
-    if (motor_direction(_AXIS(A))) {            \
-      A##_APPLY_DIR(INVERT_##A##_DIR, false);   \
-      count_direction[_AXIS(A)] = -1;           \
-    }                                           \
-    else {                                      \
-      A##_APPLY_DIR(!INVERT_##A##_DIR, false);  \
-      count_direction[_AXIS(A)] = 1;            \
+  // shaping_isr() drives the DIR pins of shaped axes
+  #if ENABLED(INPUT_SHAPING)
+    #define SHAPED_X shaping_x.impulses
+    #define SHAPED_Y shaping_y.impulses
+  #else
+    #define SHAPED_X false
+    #define SHAPED_Y false
+  #endif
+  #define SHAPED_Z false
+
+  #define SET_STEP_DIR(A)                                       \
+    if (motor_direction(_AXIS(A))) {                            \
+      if (!SHAPED_##A) A##_APPLY_DIR(INVERT_##A##_DIR, false);  \
+      count_direction[_AXIS(A)] = -1;                           \
+    }                                                           \
+    else {                                                      \
+      if (!SHAPED_##A) A##_APPLY_DIR(!INVERT_##A##_DIR, false); \
+      count_direction[_AXIS(A)] = 1;                            \
     }
 
   #if HAS_X_DIR
@@ -484,6 +556,12 @@ void Stepper::set_directions() {
         count_direction.e = 1;
       }
     #endif
+  #else
+    // Linear advance sets the E direction pins, but the E count follows the block
+    count_direction.e = motor_direction(E_AXIS) ? -1 : 1;
+    #if ENABLED(LA_MERGE_STEPS)
+      LA_E_DIR(LA_reverse); // For a new extruder
+    #endif
   #endif // !LIN_ADVANCE
 
   #if HAS_L64XX
@@ -1321,6 +1399,8 @@ void Stepper::set_directions() {
  * Directly pulses the stepper motors at high frequency.
  */
 
+#if DISABLED(STEP_STREAM) // The HAL plays the frames from its own ISR
+
 HAL_STEP_TIMER_ISR() {
   HAL_timer_isr_prologue(STEP_TIMER_NUM);
 
@@ -1329,6 +1409,8 @@ HAL_STEP_TIMER_ISR() {
   HAL_timer_isr_epilogue(STEP_TIMER_NUM);
 }
 
+#endif
+
 #ifdef CPU_32_BIT
   #define STEP_MULTIPLY(A,B) MultiU32X24toH32(A, B)
 #else
@@ -1350,6 +1432,8 @@ void Stepper::isr() {
   // periods to big periods are respected and the timer does not reset to 0
   HAL_timer_set_compare(STEP_TIMER_NUM, hal_timer_t(HAL_TIMER_TYPE_MAX));
 
+  STEPPER_PROFILE(ISR);
+
   // Count of ticks for the next ISR
   hal_timer_t next_isr_ticks = 0;
 
@@ -1364,7 +1448,7 @@ void Stepper::isr() {
 
     if (!nextMainISR) pulse_phase_isr();                            // 0 = Do coordinated axes Stepper pulses
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_LA_ISR
       if (!nextAdvanceISR) nextAdvanceISR = advance_isr();          // 0 = Do Linear Advance E Stepper pulses
     #endif
 
@@ -1373,6 +1457,11 @@ void Stepper::isr() {
       if (is_babystep) nextBabystepISR = babystepping_isr();
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      if (!nextShapingISR || !nextMainISR)                          // 0 = Do shaped X/Y pulses, also
+        nextShapingISR = shaping_isr();                             // after new steps were commanded
+    #endif
+
     // ^== Time critical. NOTHING besides pulse generation should be above here!!!
 
     if (!nextMainISR) nextMainISR = block_phase_isr();  // Manage acc/deceleration, get next block
@@ -1388,12 +1477,15 @@ void Stepper::isr() {
     // Get the interval to the next ISR call
     const uint32_t interval = _MIN(
       nextMainISR                                       // Time until the next Pulse / Block phase
-      #if ENABLED(LIN_ADVANCE)
+      #if HAS_LA_ISR
         , nextAdvanceISR                                // Come back early for Linear Advance?
       #endif
       #if ENABLED(INTEGRATED_BABYSTEPPING)
         , nextBabystepISR                               // Come back early for Babystepping?
       #endif
+      #if ENABLED(INPUT_SHAPING)
+        , nextShapingISR                                // Come back early for a shaped step?
+      #endif
       , uint32_t(HAL_TIMER_TYPE_MAX)                    // Come back in a very long time
     );
 
@@ -1406,7 +1498,7 @@ void Stepper::isr() {
 
     nextMainISR -= interval;
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_LA_ISR
       if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
     #endif
 
@@ -1414,6 +1506,11 @@ void Stepper::isr() {
       if (nextBabystepISR != BABYSTEP_NEVER) nextBabystepISR -= interval;
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      if (nextShapingISR != SHAPING_NEVER) nextShapingISR -= interval;
+      shaping_clock += interval;
+    #endif
+
     /**
      * This needs to avoid a race-condition caused by interleaving
      * of interrupts required by both the LA and Stepper algorithms.
@@ -1487,7 +1584,202 @@ void Stepper::isr() {
 }
 
 #define ISR_PULSE_CONTROL (MINIMUM_STEPPER_PULSE || MAXIMUM_STEPPER_RATE)
-#define ISR_MULTI_STEPS (ISR_PULSE_CONTROL && DISABLED(I2S_STEPPER_STREAM))
+#define ISR_MULTI_STEPS (ISR_PULSE_CONTROL && NONE(I2S_STEPPER_STREAM, STEP_STREAM))
+
+#if ENABLED(STEP_STREAM)
+  // The steps of one ISR go in frames a full pulse apart
+  #define STREAM_PULSE_TICKS _MAX(hal_timer_t(1), PULSE_HIGH_TICK_COUNT + PULSE_LOW_TICK_COUNT)
+#endif
+
+#if ENABLED(INPUT_SHAPING)
+
+  #define SHAPING_NEXT(I) shaping_index_t(uint32_t((I) + 1) < (SHAPING_BUFFER_SIZE) ? (I) + 1 : 0)
+
+  /**
+   * Input Shaping
+   *
+   * Each commanded step of a shaped axis is replayed as 2 or 3 impulses of
+   * a fraction of a step, the first right away and the others after their
+   * delays. The motor follows the sum of the replayed impulses, rounded to
+   * whole steps, so it moves along the commanded motion convolved with the
+   * shaper. The planner and count_position see the commanded motion.
+   */
+  void Stepper::set_shaping(const AxisEnum axis, const shaping_settings_t &settings) {
+    shaping_axis_t &s = axis == X_AXIS ? shaping_x : shaping_y;
+
+    // Amplitudes, and times in periods of the damped ringing
+    float a[SHAPING_MAX_IMPULSES], t[SHAPING_MAX_IMPULSES], period = 0;
+    uint8_t impulses = 0;
+    if (settings.frequency > 0) {
+      const float zeta = settings.zeta, root = SQRT(1 - sq(zeta)),
+                  K = expf(-zeta * float(M_PI) / root);
+      period = 1 / (settings.frequency * root);
+      a[0] = 1; t[0] = 0;
+      switch (settings.type) {
+        default:
+        case SHAPER_ZV:
+          impulses = 2;
+          a[1] = K; t[1] = 0.5f;
+          break;
+        case SHAPER_ZVD:
+          impulses = 3;
+          a[1] = 2 * K; t[1] = 0.5f;
+          a[2] = sq(K); t[2] = 1;
+          break;
+        case SHAPER_MZV: {
+          const float K = expf(-0.75f * zeta * float(M_PI) / root);
+          impulses = 3;
+          a[0] = 1 - float(M_SQRT1_2);
+          a[1] = (float(M_SQRT2) - 1) * K; t[1] = 0.375f;
+          a[2] = a[0] * sq(K); t[2] = 0.75f;
+        } break;
+        case SHAPER_EI: {
+          constexpr float vibration_tolerance = 0.05f;
+          impulses = 3;
+          a[0] = 0.25f * (1 + vibration_tolerance);
+          a[1] = 0.5f * (1 - vibration_tolerance) * K; t[1] = 0.5f;
+          a[2] = a[0] * sq(K); t[2] = 1;
+        } break;
+      }
+    }
+
+    // Let the old shaper finish its steps
+    planner.synchronize();
+
+    const bool was_enabled = suspend();
+    float sum = 0;
+    LOOP_L_N(i, impulses) sum += a[i];
+    int32_t total = 0;
+    LOOP_L_N(i, impulses) {
+      s.amplitude[i] = i < impulses - 1 ? int32_t(LROUND(a[i] / sum * SHAPING_ONE)) : SHAPING_ONE - total;
+      total += s.amplitude[i];
+      s.delay[i] = LROUND(t[i] * period * (STEPPER_TIMER_RATE));
+      s.echo[i] = 0;
+    }
+    s.head = 0;
+    s.error = 0;
+    s.settings = settings;
+    s.impulses = impulses;
+    // Hand the DIR pin back to set_directions()
+    if (!impulses && s.direction) set_directions();
+    s.direction = 0;
+    if (was_enabled) wake_up();
+  }
+
+  // Record a commanded step of a shaped axis and add its first impulse
+  FORCE_INLINE void Stepper::shaping_push(shaping_axis_t &s, const bool forward) {
+    #ifdef HAL_STEP_ANALYZER
+      HAL_commanded_step(&s == &shaping_x ? X_AXIS : Y_AXIS, forward);
+    #endif
+    const shaping_index_t next = SHAPING_NEXT(s.head), oldest = s.echo[s.impulses - 1];
+    if (next == oldest) {
+      // Out of room: replay all of the oldest step now
+      const bool oldest_forward = TEST(s.step_time[oldest], 0);
+      for (uint8_t i = 1; i < s.impulses; i++) if (s.echo[i] == oldest) {
+        s.error += oldest_forward ? s.amplitude[i] : -s.amplitude[i];
+        s.echo[i] = SHAPING_NEXT(oldest);
+      }
+      #ifdef HAL_BENCHMARK
+        HAL_BENCH_COUNT(shaping_overflows);
+      #endif
+    }
+    s.step_time[s.head] = (shaping_clock & ~1UL) | forward;
+    s.head = next;
+    s.error += forward ? s.amplitude[0] : -s.amplitude[0];
+  }
+
+  // Add the delayed impulses that are due, bring 'interval' down to the
+  // time of the next one, and return the steps that take the motor to the
+  // replayed position
+  int16_t Stepper::shaping_due(shaping_axis_t &s, uint32_t &interval) {
+    for (uint8_t i = 1; i < s.impulses; i++) {
+      for (shaping_index_t &e = s.echo[i]; e != s.head; e = SHAPING_NEXT(e)) {
+        const uint32_t step_time = s.step_time[e];
+        const int32_t wait = int32_t((step_time & ~1UL) + s.delay[i] - shaping_clock);
+        if (wait > 0) { NOMORE(interval, uint32_t(wait)); break; }
+        s.error += TEST(step_time, 0) ? s.amplitude[i] : -s.amplitude[i];
+      }
+    }
+    int16_t steps = 0;
+    for (; s.error > SHAPING_ONE / 2; s.error -= SHAPING_ONE) steps++;
+    for (; s.error < -(SHAPING_ONE / 2); s.error += SHAPING_ONE) steps--;
+    return steps;
+  }
+
+  // Stop a shaped axis where its motor is: drop the impulses not replayed
+  // yet and take the steps they were due to make off count_position
+  void Stepper::shaping_abort(shaping_axis_t &s, const AxisEnum axis) {
+    #ifdef HAL_STEP_ANALYZER
+      HAL_shaping_stop(axis);
+    #endif
+    int64_t pending = s.error;
+    for (uint8_t i = 1; i < s.impulses; i++) {
+      int32_t steps = 0;
+      for (shaping_index_t e = s.echo[i]; e != s.head; e = SHAPING_NEXT(e))
+        steps += TEST(s.step_time[e], 0) ? 1 : -1;
+      pending += int64_t(steps) * s.amplitude[i];
+      s.echo[i] = s.head;
+    }
+    s.error = 0;
+    count_position[axis] -= int32_t(pending / SHAPING_ONE);
+  }
+
+  // Timer interrupt for the shaped X and Y steps
+  uint32_t Stepper::shaping_isr() {
+    STEPPER_PROFILE(SHAPING);
+    uint32_t interval = SHAPING_NEVER;
+    int16_t x_steps = shaping_x.impulses ? shaping_due(shaping_x, interval) : 0,
+            y_steps = shaping_y.impulses ? shaping_due(shaping_y, interval) : 0;
+    if (!x_steps && !y_steps) return interval;
+
+    const int8_t x_dir = x_steps < 0 ? -1 : 1, y_dir = y_steps < 0 ? -1 : 1;
+    const bool x_turn = x_steps && x_dir != shaping_x.direction,
+               y_turn = y_steps && y_dir != shaping_y.direction;
+    if (x_turn || y_turn) {
+      DIR_WAIT_BEFORE();
+      if (x_turn) { X_APPLY_DIR(x_dir > 0 ? !INVERT_X_DIR : INVERT_X_DIR, false); shaping_x.direction = x_dir; }
+      if (y_turn) { Y_APPLY_DIR(y_dir > 0 ? !INVERT_Y_DIR : INVERT_Y_DIR, false); shaping_y.direction = y_dir; }
+      DIR_WAIT_AFTER();
+    }
+    x_steps = ABS(x_steps);
+    y_steps = ABS(y_steps);
+
+    #if ISR_MULTI_STEPS
+      bool firstStep = true;
+      USING_TIMED_PULSE();
+    #endif
+
+    do {
+      #if ISR_MULTI_STEPS
+        if (firstStep)
+          firstStep = false;
+        else
+          AWAIT_LOW_PULSE();
+      #endif
+
+      // Set the STEP pulses ON
+      if (x_steps) X_APPLY_STEP(!INVERT_X_STEP_PIN, 0);
+      if (y_steps) Y_APPLY_STEP(!INVERT_Y_STEP_PIN, 0);
+
+      // Enforce a minimum duration for STEP pulse ON
+      #if ISR_MULTI_STEPS
+        START_HIGH_PULSE();
+        AWAIT_HIGH_PULSE();
+      #endif
+
+      // Set the STEP pulses OFF
+      if (x_steps) { X_APPLY_STEP(INVERT_X_STEP_PIN, 0); x_steps--; }
+      if (y_steps) { Y_APPLY_STEP(INVERT_Y_STEP_PIN, 0); y_steps--; }
+
+      #if ISR_MULTI_STEPS
+        if (x_steps || y_steps) START_LOW_PULSE();
+      #endif
+    } while (x_steps || y_steps);
+
+    return interval;
+  }
+
+#endif // INPUT_SHAPING
 
 /**
  * This phase of the ISR should ONLY create the pulses for the steppers.
@@ -1497,10 +1789,15 @@ void Stepper::isr() {
  * is to keep pulse timing as regular as possible.
  */
 void Stepper::pulse_phase_isr() {
+  STEPPER_PROFILE(PULSE);
 
   // If we must abort the current block, do so!
   if (abort_current_block) {
     abort_current_block = false;
+    #if ENABLED(INPUT_SHAPING)
+      if (shaping_x.impulses) shaping_abort(shaping_x, X_AXIS);
+      if (shaping_y.impulses) shaping_abort(shaping_y, Y_AXIS);
+    #endif
     if (current_block) {
       axis_did_move = 0;
       current_block = nullptr;
@@ -1509,7 +1806,13 @@ void Stepper::pulse_phase_isr() {
   }
 
   // If there is no current block, do nothing
-  if (!current_block) return;
+  if (!current_block) {
+    #if ENABLED(LA_MERGE_STEPS)
+      // ...but the E steps left over from the last block
+      if (LA_steps) la_step_out();
+    #endif
+    return;
+  }
 
   // Count of pending loops and events for this iteration
   const uint32_t pending_events = step_event_count - step_events_completed;
@@ -1525,7 +1828,19 @@ void Stepper::pulse_phase_isr() {
   #endif
   xyze_bool_t step_needed{0};
 
+  #if ENABLED(STEP_STREAM)
+    hal_timer_t event_time = stream_clock;
+  #endif
+
   do {
+    #if ENABLED(ARC_BLOCKS)
+      // Aim X and Y at the next chord of an arc
+      if (arc_chords_left) {
+        if (!arc_events_left) arc_next_chord();
+        --arc_events_left;
+      }
+    #endif
+
     #define _APPLY_STEP(AXIS, INV, ALWAYS) AXIS ##_APPLY_STEP(INV, ALWAYS)
     #define _INVERT_STEP_PIN(AXIS) INVERT_## AXIS ##_STEP_PIN
 
@@ -1539,19 +1854,38 @@ void Stepper::pulse_phase_isr() {
       } \
     }while(0)
 
-    // Start an active pulse, if Bresenham says so, and update position
-    #define PULSE_START(AXIS) do{ \
-      if (step_needed[_AXIS(AXIS)]) { \
-        _APPLY_STEP(AXIS, !_INVERT_STEP_PIN(AXIS), 0); \
-      } \
-    }while(0)
+    #if ENABLED(STEP_STREAM)
+      // Put the steps in a frame, stream_output() makes the pulse
+      uint8_t stream_step = 0;
+      #define PULSE_START(AXIS) do{ if (step_needed[_AXIS(AXIS)]) SBI(stream_step, _AXIS(AXIS)); }while(0)
+      #define PULSE_STOP(AXIS) NOOP
+    #else
+      // Start an active pulse, if Bresenham says so, and update position
+      #define PULSE_START(AXIS) do{ \
+        if (step_needed[_AXIS(AXIS)]) { \
+          _APPLY_STEP(AXIS, !_INVERT_STEP_PIN(AXIS), 0); \
+        } \
+      }while(0)
+
+      // Stop an active pulse, if any, and adjust error term
+      #define PULSE_STOP(AXIS) do { \
+        if (step_needed[_AXIS(AXIS)]) { \
+          _APPLY_STEP(AXIS, _INVERT_STEP_PIN(AXIS), 0); \
+        } \
+      }while(0)
+    #endif
 
-    // Stop an active pulse, if any, and adjust error term
-    #define PULSE_STOP(AXIS) do { \
-      if (step_needed[_AXIS(AXIS)]) { \
-        _APPLY_STEP(AXIS, _INVERT_STEP_PIN(AXIS), 0); \
-      } \
-    }while(0)
+    #if ENABLED(INPUT_SHAPING)
+      // Shaped axes hand their steps to shaping_isr() instead of the STEP pin
+      #define SHAPED_PULSE_START(AXIS, S) do{ \
+        if (!S.impulses) PULSE_START(AXIS); \
+        else if (step_needed[_AXIS(AXIS)]) shaping_push(S, count_direction[_AXIS(AXIS)] > 0); \
+      }while(0)
+      #define SHAPED_PULSE_STOP(AXIS, S) do{ if (!S.impulses) PULSE_STOP(AXIS); }while(0)
+    #else
+      #define SHAPED_PULSE_START(AXIS, S) PULSE_START(AXIS)
+      #define SHAPED_PULSE_STOP(AXIS, S) PULSE_STOP(AXIS)
+    #endif
 
     // Determine if pulses are needed
     #if HAS_X_STEP
@@ -1580,6 +1914,23 @@ void Stepper::pulse_phase_isr() {
       PULSE_PREP(E);
     #endif
 
+    #if ENABLED(LA_MERGE_STEPS)
+      // Step E once per event toward the steps to perform, advance included
+      if (LA_steps) {
+        const bool reverse = LA_steps < 0;
+        if (reverse != LA_reverse) {
+          LA_reverse = reverse;
+          #if DISABLED(STEP_STREAM)
+            DIR_WAIT_BEFORE();
+            LA_E_DIR(reverse);
+            DIR_WAIT_AFTER();
+          #endif
+        }
+        reverse ? ++LA_steps : --LA_steps;
+        step_needed.e = true;
+      }
+    #endif
+
     #if ISR_MULTI_STEPS
       if (firstStep)
         firstStep = false;
@@ -1589,16 +1940,16 @@ void Stepper::pulse_phase_isr() {
 
     // Pulse start
     #if HAS_X_STEP
-      PULSE_START(X);
+      SHAPED_PULSE_START(X, shaping_x);
     #endif
     #if HAS_Y_STEP
-      PULSE_START(Y);
+      SHAPED_PULSE_START(Y, shaping_y);
     #endif
     #if HAS_Z_STEP
       PULSE_START(Z);
     #endif
 
-    #if DISABLED(LIN_ADVANCE)
+    #if !HAS_LA_ISR
       #if ENABLED(MIXING_EXTRUDER)
         if (step_needed.e) E_STEP_WRITE(mixer.get_next_stepper(), !INVERT_E_STEP_PIN);
       #elif HAS_E0_STEP
@@ -1608,6 +1959,13 @@ void Stepper::pulse_phase_isr() {
 
     #if ENABLED(I2S_STEPPER_STREAM)
       i2s_push_sample();
+    #elif ENABLED(STEP_STREAM)
+      #if ENABLED(LA_MERGE_STEPS)
+        stream_push(event_time, stream_step, LA_reverse ? last_direction_bits | _BV(E_AXIS) : last_direction_bits & ~_BV(E_AXIS));
+      #else
+        stream_push(event_time, stream_step, last_direction_bits);
+      #endif
+      event_time += STREAM_PULSE_TICKS;
     #endif
 
     // TODO: need to deal with MINIMUM_STEPPER_PULSE over i2s
@@ -1618,21 +1976,25 @@ void Stepper::pulse_phase_isr() {
 
     // Pulse stop
     #if HAS_X_STEP
-      PULSE_STOP(X);
+      SHAPED_PULSE_STOP(X, shaping_x);
     #endif
     #if HAS_Y_STEP
-      PULSE_STOP(Y);
+      SHAPED_PULSE_STOP(Y, shaping_y);
     #endif
     #if HAS_Z_STEP
       PULSE_STOP(Z);
     #endif
 
-    #if DISABLED(LIN_ADVANCE)
+    #if !HAS_LA_ISR
       #if ENABLED(MIXING_EXTRUDER)
-        if (delta_error.e >= 0) {
-          delta_error.e -= advance_divisor;
-          E_STEP_WRITE(mixer.get_stepper(), INVERT_E_STEP_PIN);
-        }
+        #if ENABLED(LIN_ADVANCE)
+          if (step_needed.e) E_STEP_WRITE(mixer.get_stepper(), INVERT_E_STEP_PIN);
+        #else
+          if (delta_error.e >= 0) {
+            delta_error.e -= advance_divisor;
+            E_STEP_WRITE(mixer.get_stepper(), INVERT_E_STEP_PIN);
+          }
+        #endif
       #elif HAS_E0_STEP
         PULSE_STOP(E);
       #endif
@@ -1645,11 +2007,55 @@ void Stepper::pulse_phase_isr() {
   } while (--events_to_do);
 }
 
+#if ENABLED(ARC_BLOCKS)
+
+  /**
+   * Step X and Y along the next chord of the current arc block.
+   *
+   * The radius vector is turned by one chord, and the chord's steps are
+   * spread over its events with the block's Bresenham divisor, so Z and E
+   * carry on over the whole block. The last chord ends exactly on target.
+   */
+  void Stepper::arc_next_chord() {
+    xy_long_t vertex;
+    if (--arc_chords_left) {
+      constexpr int64_t half = _BV32(ARC_ROTATE_FRACT_BITS - 1);
+      const int64_t rx = arc_radius.x, ry = arc_radius.y;
+      arc_radius.x = (rx * current_block->arc_cos - ry * current_block->arc_sin_x + half) >> (ARC_ROTATE_FRACT_BITS);
+      arc_radius.y = (rx * current_block->arc_sin_y + ry * current_block->arc_cos + half) >> (ARC_ROTATE_FRACT_BITS);
+      constexpr int32_t round = _BV32(ARC_RADIUS_FRACT_BITS - 1);
+      vertex.set((current_block->arc_center.x + arc_radius.x + round) >> (ARC_RADIUS_FRACT_BITS),
+                 (current_block->arc_center.y + arc_radius.y + round) >> (ARC_RADIUS_FRACT_BITS));
+    }
+    else
+      vertex = current_block->arc_end;
+
+    const int32_t dx = vertex.x - arc_vertex.x, dy = vertex.y - arc_vertex.y;
+    arc_vertex = vertex;
+
+    // Over the chord's events, |dx| steps of the block's divisor
+    advance_dividend.x = uint32_t(ABS(dx)) * current_block->arc_chords << 1;
+    advance_dividend.y = uint32_t(ABS(dy)) * current_block->arc_chords << 1;
+    arc_events_left = current_block->arc_chord_events << oversampling_factor;
+
+    // Keep the direction of an axis that doesn't move
+    uint8_t dirs = last_direction_bits;
+    if (dx) SET_BIT_TO(dirs, X_AXIS, dx < 0);
+    if (dy) SET_BIT_TO(dirs, Y_AXIS, dy < 0);
+    if (dirs != last_direction_bits) {
+      last_direction_bits = dirs;
+      set_directions();
+    }
+  }
+
+#endif // ARC_BLOCKS
+
 // This is the last half of the stepper interrupt: This one processes and
 // properly schedules blocks from the planner. This is executed after creating
 // the step pulses, so it is not time critical, as pulses are already done.
 
 uint32_t Stepper::block_phase_isr() {
+  STEPPER_PROFILE(BLOCK);
 
   // If no queued movements, just wait 1ms for the next block
   uint32_t interval = (STEPPER_TIMER_RATE) / 1000UL;
@@ -1665,6 +2071,16 @@ uint32_t Stepper::block_phase_isr() {
       axis_did_move = 0;
       current_block = nullptr;
       planner.discard_current_block();
+      #ifdef HAL_BENCHMARK
+        // The planner ran dry (includes the end of a print and deliberate waits)
+        if (!planner.has_blocks_queued()) HAL_BENCH_COUNT(starved);
+      #endif
+      #if ENABLED(PLANNER_STATS)
+        if (!planner.has_blocks_queued() && printingIsActive()) {
+          starved++;
+          if (queue.length) starved_waiting++;
+        }
+      #endif
     }
     else {
       // Step events not completed yet...
@@ -1672,6 +2088,25 @@ uint32_t Stepper::block_phase_isr() {
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
+        #if ENABLED(STEP_SCHEDULE)
+          if (schedule_accel && !schedule_skip) {
+            // Take the timer interval worked out ahead of time
+            const uint32_t entry = *schedule_next++;
+            schedule_accel--;
+            interval = entry >> 3;
+            steps_per_isr = _BV(entry & 0x07);
+            #if ENABLED(LA_MERGE_STEPS)
+              // The schedule has no step rate, so take it from the interval
+              if (LA_use_advance_lead) la_follow((STEPPER_TIMER_RATE) / (interval >> (entry & 0x07)), true);
+            #endif
+          }
+          else {
+            if (schedule_skip) schedule_skip--;
+            #ifdef HAL_BENCHMARK
+              HAL_BENCH_COUNT(ramp_intervals);
+            #endif
+        #endif
+
         #if ENABLED(S_CURVE_ACCELERATION)
           // Get the next speed to use (Jerk limited!)
           uint32_t acc_step_rate =
@@ -1687,9 +2122,18 @@ uint32_t Stepper::block_phase_isr() {
 
         // step_rate to timer interval and steps per stepper isr
         interval = calc_timer_interval(acc_step_rate, &steps_per_isr);
+
+        #if ENABLED(LA_MERGE_STEPS)
+          if (LA_use_advance_lead) la_follow(acc_step_rate, true);
+        #endif
+
+        #if ENABLED(STEP_SCHEDULE)
+          }
+        #endif
+
         acceleration_time += interval;
 
-        #if ENABLED(LIN_ADVANCE)
+        #if HAS_LA_ISR
           // Fire ISR if final adv_rate is reached
           if (LA_steps && (!LA_use_advance_lead || LA_isr_rate != current_block->advance_speed))
             initiateLA();
@@ -1699,6 +2143,34 @@ uint32_t Stepper::block_phase_isr() {
       else if (step_events_completed > decelerate_after) {
         uint32_t step_rate;
 
+        #if ENABLED(STEP_SCHEDULE)
+          if (schedule_decel) {
+            // Skip any acceleration entries left over
+            schedule_next += schedule_accel;
+            schedule_accel = 0;
+            // Take the timer interval worked out ahead of time
+            const uint32_t entry = *schedule_next++;
+            interval = entry >> 3;
+            steps_per_isr = _BV(entry & 0x07);
+            #if ENABLED(LA_MERGE_STEPS)
+              if (LA_use_advance_lead) la_follow((STEPPER_TIMER_RATE) / (interval >> (entry & 0x07)), false);
+            #endif
+            #if ENABLED(S_CURVE_ACCELERATION)
+              // The ISR carries on if the ramp outlasts the schedule
+              if (!--schedule_decel) {
+                _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+                bezier_2nd_half = true;
+              }
+            #else
+              schedule_decel--;
+            #endif
+          }
+          else {
+            #ifdef HAL_BENCHMARK
+              HAL_BENCH_COUNT(ramp_intervals);
+            #endif
+        #endif
+
         #if ENABLED(S_CURVE_ACCELERATION)
           // If this is the 1st time we process the 2nd half of the trapezoid...
           if (!bezier_2nd_half) {
@@ -1730,9 +2202,18 @@ uint32_t Stepper::block_phase_isr() {
 
         // step_rate to timer interval and steps per stepper isr
         interval = calc_timer_interval(step_rate, &steps_per_isr);
+
+        #if ENABLED(LA_MERGE_STEPS)
+          if (LA_use_advance_lead) la_follow(step_rate, false);
+        #endif
+
+        #if ENABLED(STEP_SCHEDULE)
+          }
+        #endif
+
         deceleration_time += interval;
 
-        #if ENABLED(LIN_ADVANCE)
+        #if HAS_LA_ISR
           if (LA_use_advance_lead) {
             // Wake up eISR on first deceleration loop and fire ISR if final adv_rate is reached
             if (step_events_completed <= decelerate_after + steps_per_isr || (LA_steps && LA_isr_rate != current_block->advance_speed)) {
@@ -1746,13 +2227,20 @@ uint32_t Stepper::block_phase_isr() {
       // We must be in cruise phase otherwise
       else {
 
-        #if ENABLED(LIN_ADVANCE)
+        #if HAS_LA_ISR
           // If there are any esteps, fire the next advance_isr "now"
           if (LA_steps && LA_isr_rate != current_block->advance_speed) initiateLA();
         #endif
 
         // Calculate the ticks_nominal for this nominal speed, if not done yet
         if (ticks_nominal < 0) {
+          #if ENABLED(STEP_SCHEDULE)
+            if (schedule_nominal) {
+              ticks_nominal = schedule_nominal >> 3;
+              steps_per_isr = _BV(schedule_nominal & 0x07);
+            }
+            else
+          #endif
           // step_rate to timer interval and loops for the nominal speed
           ticks_nominal = calc_timer_interval(current_block->nominal_rate, &steps_per_isr);
         }
@@ -1785,7 +2273,7 @@ uint32_t Stepper::block_phase_isr() {
       #endif
 
       #if ENABLED(POWER_LOSS_RECOVERY)
-        recovery.info.sdpos = current_block->sdpos;
+        recovery.info.sdpos = planner.plan_of(current_block).sdpos;
       #endif
 
       // Flag all moving axes for proper endstop handling
@@ -1911,10 +2399,16 @@ uint32_t Stepper::block_phase_isr() {
         if ((LA_use_advance_lead = current_block->use_advance_lead)) {
           LA_final_adv_steps = current_block->final_adv_steps;
           LA_max_adv_steps = current_block->max_adv_steps;
-          initiateLA(); // Start the ISR
-          LA_isr_rate = current_block->advance_speed;
+          #if HAS_LA_ISR
+            initiateLA(); // Start the ISR
+            LA_isr_rate = current_block->advance_speed;
+          #else
+            LA_adv_steps_per_rate = current_block->adv_steps_per_rate;
+          #endif
         }
-        else LA_isr_rate = LA_ADV_NEVER;
+        #if HAS_LA_ISR
+          else LA_isr_rate = LA_ADV_NEVER;
+        #endif
       #endif
 
       if (
@@ -1938,6 +2432,16 @@ uint32_t Stepper::block_phase_isr() {
         set_directions();
       }
 
+      #if ENABLED(ARC_BLOCKS)
+        // Start an arc on its first chord
+        if ((arc_chords_left = current_block->arc_chords)) {
+          arc_radius = current_block->arc_radius;
+          arc_vertex.set(current_block->arc_center.x + arc_radius.x, current_block->arc_center.y + arc_radius.y);
+          arc_vertex.set(arc_vertex.x >> ARC_RADIUS_FRACT_BITS, arc_vertex.y >> ARC_RADIUS_FRACT_BITS);
+          arc_next_chord();
+        }
+      #endif
+
       // At this point, we must ensure the movement about to execute isn't
       // trying to force the head against a limit switch. If using interrupt-
       // driven change detection, and already against a limit then no call to
@@ -1969,8 +2473,36 @@ uint32_t Stepper::block_phase_isr() {
         bezier_2nd_half = false;
       #endif
 
+      #if ENABLED(STEP_SCHEDULE)
+        // Use the ramps worked out ahead of time, if they're ready
+        const step_schedule_t &s = schedule[current_block - planner.block_buffer];
+        if (s.ready) {
+          schedule_next = s.entry;
+          schedule_skip = s.skip;
+          schedule_accel = s.accel;
+          schedule_decel = s.decel;
+          schedule_nominal = s.nominal;
+          #if DISABLED(S_CURVE_ACCELERATION)
+            acc_step_rate = s.acc_step_rate;
+          #endif
+          interval = s.first >> 3;
+          steps_per_isr = _BV(s.first & 0x07);
+        }
+        else {
+          schedule_skip = 0;
+          schedule_accel = schedule_decel = 0;
+          schedule_nominal = 0;
+          #ifdef HAL_BENCHMARK
+            HAL_BENCH_COUNT(unscheduled);
+          #endif
+      #endif
+
       // Calculate the initial timer interval
       interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr);
+
+      #if ENABLED(STEP_SCHEDULE)
+        }
+      #endif
     }
   }
 
@@ -1978,46 +2510,339 @@ uint32_t Stepper::block_phase_isr() {
   return interval;
 }
 
-#if ENABLED(LIN_ADVANCE)
+#if ENABLED(STEP_SCHEDULE)
+
+  #define sw_barrier() asm volatile("": : :"memory");
+
+  #if ENABLED(S_CURVE_ACCELERATION)
+
+    // The Bézier speed curve of _calc_bezier_curve_coeffs() / _eval_bezier_curve()
+    // for 32-bit CPUs, with its own coefficients as the ISR uses the static ones
+    struct schedule_curve_t {
+      int32_t a, b, c;
+      uint32_t f, av;
+
+      schedule_curve_t(const int32_t v0, const int32_t v1, const uint32_t av)
+        : a(768 * (v1 - v0)), b(1920 * (v0 - v1)), c(1280 * (v1 - v0)), f(128 * v0), av(av) {}
+
+      int32_t eval(const uint32_t curr_step) const {
+        const uint32_t t = av * curr_step;
+        uint64_t p = t;
+        p *= t; p >>= 32;
+        p *= t; p >>= 32;
+        int64_t acc = (int64_t)f << 31;
+        acc += ((uint32_t)p >> 1) * (int64_t)c;
+        p *= t; p >>= 32;
+        acc += ((uint32_t)p >> 1) * (int64_t)b;
+        p *= t; p >>= 32;
+        acc += ((uint32_t)p >> 1) * (int64_t)a;
+        return int32_t(acc >> (31 + 7));
+      }
+    };
 
-  // Timer interrupt for E. LA_steps is set in the main routine
-  uint32_t Stepper::advance_isr() {
-    uint32_t interval;
+  #endif
 
-    if (LA_use_advance_lead) {
-      if (step_events_completed > decelerate_after && LA_current_adv_steps > LA_final_adv_steps) {
-        LA_steps--;
-        LA_current_adv_steps--;
-        interval = LA_isr_rate;
+  /**
+   * Step Schedule
+   *
+   * Run the trapezoid generator of block_phase_isr() over a block ahead of
+   * time, keeping the timer interval and steps per ISR of its calls on the
+   * ramps. Up to half of the entries go to the end of the acceleration and
+   * the rest to the start of the deceleration, where the step rate and so
+   * the ISR load is highest. The ISR times the other calls by itself.
+   *
+   * The step pattern itself stays in pulse_phase_isr(), since Bresenham
+   * costs a few additions per step and storing it would cost a byte.
+   */
+  void Stepper::schedule_block(const block_t * const block, step_schedule_t &s) {
+
+    uint8_t oversampling = 0;
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      // The oversampling block_phase_isr() will pick
+      uint32_t max_rate = block->nominal_rate;
+      while (max_rate < MIN_STEP_ISR_FREQUENCY) {
+        max_rate <<= 1;
+        if (max_rate >= MAX_STEP_ISR_FREQUENCY_1X) break;
+        ++oversampling;
       }
-      else if (step_events_completed < decelerate_after && LA_current_adv_steps < LA_max_adv_steps) {
-             //step_events_completed <= (uint32_t)accelerate_until) {
-        LA_steps++;
-        LA_current_adv_steps++;
-        interval = LA_isr_rate;
+    #endif
+
+    const uint32_t event_count = block->step_event_count << oversampling,
+                   accel_until = block->accelerate_until << oversampling,
+                   decel_after = block->decelerate_after << oversampling;
+
+    uint8_t multi, nominal_multi;
+    uint32_t interval = calc_timer_interval(block->initial_rate, oversampling, &multi);
+    s.first = SCHEDULE_ENTRY(interval, multi);
+    interval = calc_timer_interval(block->nominal_rate, oversampling, &nominal_multi);
+    s.nominal = SCHEDULE_ENTRY(interval, nominal_multi);
+
+    #if ENABLED(S_CURVE_ACCELERATION)
+      schedule_curve_t curve(block->initial_rate, block->cruise_rate, block->acceleration_time_inverse);
+      bool second_half = false;
+    #else
+      uint32_t acc_rate = block->initial_rate;
+    #endif
+
+    constexpr uint16_t half = (STEP_SCHEDULE_SIZE) / 2;
+    uint16_t decel = 0;
+    uint32_t accel = 0, accel_time = 0, decel_time = 0;
+    for (uint32_t events = 0;;) {
+      events += _MIN(event_count - events, uint32_t(multi));
+      if (events >= event_count) break;
+
+      uint32_t rate;
+      if (events <= accel_until) {
+        #if ENABLED(S_CURVE_ACCELERATION)
+          rate = accel_time < block->acceleration_time ? curve.eval(accel_time) : block->cruise_rate;
+        #else
+          acc_rate = STEP_MULTIPLY(accel_time, block->acceleration_rate) + block->initial_rate;
+          NOMORE(acc_rate, block->nominal_rate);
+          rate = acc_rate;
+        #endif
+        interval = calc_timer_interval(rate, oversampling, &multi);
+        accel_time += interval;
+        // The last 'half' calls, in a ring
+        s.entry[accel++ % half] = SCHEDULE_ENTRY(interval, multi);
+      }
+      else if (events > decel_after) {
+        #if ENABLED(S_CURVE_ACCELERATION)
+          if (!second_half) {
+            curve = schedule_curve_t(block->cruise_rate, block->final_rate, block->deceleration_time_inverse);
+            second_half = true;
+            rate = block->cruise_rate;
+          }
+          else
+            rate = decel_time < block->deceleration_time ? curve.eval(decel_time) : block->final_rate;
+        #else
+          rate = STEP_MULTIPLY(decel_time, block->acceleration_rate);
+          if (rate < acc_rate) {
+            rate = acc_rate - rate;
+            NOLESS(rate, block->final_rate);
+          }
+          else
+            rate = block->final_rate;
+        #endif
+        interval = calc_timer_interval(rate, oversampling, &multi);
+        decel_time += interval;
+        const uint16_t used = _MIN(accel, uint32_t(half)) + decel;
+        if (used == (STEP_SCHEDULE_SIZE)) break;
+        s.entry[used] = SCHEDULE_ENTRY(interval, multi);
+        decel++;
+      }
+      else {
+        // Cruise straight to the last call before the deceleration
+        multi = nominal_multi;
+        events += (decel_after - events) / multi * multi;
       }
-      else
-        interval = LA_isr_rate = LA_ADV_NEVER;
     }
-    else
-      interval = LA_ADV_NEVER;
 
-    DIR_WAIT_BEFORE();
+    // Put the acceleration ring in order
+    if (accel > half) {
+      auto reverse = [&](uint16_t i, uint16_t j) {
+        for (; i + 1 < j; i++, j--) { const uint32_t e = s.entry[i]; s.entry[i] = s.entry[j - 1]; s.entry[j - 1] = e; }
+      };
+      const uint16_t oldest = accel % half;
+      reverse(0, oldest);
+      reverse(oldest, half);
+      reverse(0, half);
+      s.skip = accel - half;
+      s.accel = half;
+    }
+    else {
+      s.skip = 0;
+      s.accel = accel;
+    }
+    s.decel = decel;
+    #if DISABLED(S_CURVE_ACCELERATION)
+      s.acc_step_rate = acc_rate;
+    #endif
+  }
 
-    #if ENABLED(MIXING_EXTRUDER)
-      // We don't know which steppers will be stepped because LA loop follows,
-      // with potentially multiple steps. Set all.
-      if (LA_steps >= 0)
-        MIXER_STEPPER_LOOP(j) NORM_E_DIR(j);
-      else
-        MIXER_STEPPER_LOOP(j) REV_E_DIR(j);
+  void Stepper::schedule_blocks() {
+    // The blocks after the busy one with their trapezoid done. The ISR
+    // may take one at any time, and then ignores a schedule not ready yet.
+    const block_index_t head = planner.block_buffer_head;
+    for (block_index_t i = planner.block_buffer_nonbusy; i != head; i = BLOCK_MOD(i + 1)) {
+      step_schedule_t &s = schedule[i];
+      const block_t * const block = &planner.block_buffer[i];
+      if (s.ready || TEST(block->flag, BLOCK_BIT_RECALCULATE) || TEST(block->flag, BLOCK_BIT_SYNC_POSITION)) continue;
+      schedule_block(block, s);
+      sw_barrier();
+      s.ready = true;
+      // Taken meanwhile? Then leave no schedule behind for the next block in this slot.
+      const block_index_t nonbusy = planner.block_buffer_nonbusy;
+      if (BLOCK_MOD(i - nonbusy) >= BLOCK_MOD(head - nonbusy)) {
+        s.ready = false;
+        break;
+      }
+    }
+  }
+
+#endif // STEP_SCHEDULE
+
+#if ENABLED(STEP_STREAM)
+
+  /**
+   * Step Stream
+   *
+   * The pulse and block phases run ahead of the motors, on their own clock,
+   * and each pulse becomes a frame in the ring. The HAL plays the frames at
+   * their delays and calls stream_fill() to top the ring up.
+   */
+  void Stepper::stream_fill() {
+
+    static uint32_t nextMainISR = 0;  // Producer ticks until the next pulse / block phase
+
+    // Room for the steps of a pulse phase, and their E steps from advance_isr()
+    // or the E steps la_step_out() leaves after the last block
+    #if HAS_LA_ISR
+      #define STREAM_ROOM (2 * steps_per_isr + 1)
+    #elif ENABLED(LA_MERGE_STEPS)
+      #define STREAM_ROOM (steps_per_isr + ABS(LA_steps))
     #else
-      if (LA_steps >= 0)
-        NORM_E_DIR(stepper_extruder);
-      else
-        REV_E_DIR(stepper_extruder);
+      #define STREAM_ROOM steps_per_isr
     #endif
 
+    while (STEP_STREAM_SIZE - 1 - step_stream.count() >= STREAM_ROOM
+      && step_stream.ahead() < hal_timer_t((STEP_STREAM_AHEAD) * ((STEPPER_TIMER_RATE) / 1000UL))
+    ) {
+      if (!nextMainISR) pulse_phase_isr();
+
+      #if HAS_LA_ISR
+        if (!nextAdvanceISR) nextAdvanceISR = advance_isr();
+      #endif
+
+      if (!nextMainISR) {
+        nextMainISR = block_phase_isr();
+        // Nothing to play until the planner has a block, unless there's E advance to undo
+        if (!current_block
+          #if HAS_LA_ISR
+            && nextAdvanceISR == LA_ADV_NEVER
+          #endif
+        ) { nextMainISR = 0; break; }
+      }
+
+      const uint32_t interval = (
+        #if HAS_LA_ISR
+          _MIN(nextMainISR, nextAdvanceISR)
+        #else
+          nextMainISR
+        #endif
+      );
+
+      nextMainISR -= interval;
+      #if HAS_LA_ISR
+        if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
+      #endif
+
+      stream_clock += interval;
+    }
+  }
+
+  // Push a frame for the steps of one event, at 'time' on the producer clock.
+  // Axes not stepping keep the direction of the frame before, so the HAL
+  // only changes DIR pins before a step.
+  void Stepper::stream_push(hal_timer_t time, const uint8_t step, const uint8_t dir) {
+    if (!step) return;
+    if (int32_t(time - stream_last) < int32_t(STREAM_PULSE_TICKS)) time = stream_last + STREAM_PULSE_TICKS;
+    step_frame_t &frame = step_stream.free_frame();
+    frame.ticks = time - stream_last;
+    frame.step = step;
+    frame.dir = stream_last_dir = (stream_last_dir & ~step) | (dir & step);
+    frame.extruder = stepper_extruder;
+    step_stream.push();
+    stream_last = time;
+  }
+
+  void Stepper::stream_output(const step_frame_t &frame) {
+
+    if (frame.dir != stream_dir || frame.extruder != stream_extruder) {
+      stream_dir = frame.dir;
+      stream_extruder = frame.extruder;
+
+      DIR_WAIT_BEFORE();
+
+      #define STREAM_DIR(A) A##_APPLY_DIR(TEST(frame.dir, _AXIS(A)) ? INVERT_##A##_DIR : !INVERT_##A##_DIR, false)
+      #if HAS_X_DIR
+        STREAM_DIR(X);
+      #endif
+      #if HAS_Y_DIR
+        STREAM_DIR(Y);
+      #endif
+      #if HAS_Z_DIR
+        STREAM_DIR(Z);
+      #endif
+      if (TEST(frame.dir, E_AXIS)) REV_E_DIR(frame.extruder); else NORM_E_DIR(frame.extruder);
+
+      DIR_WAIT_AFTER();
+    }
+
+    #define STREAM_STEP(A, V) do{ if (TEST(frame.step, _AXIS(A))) A##_APPLY_STEP(V, 0); }while(0)
+
+    #if ISR_PULSE_CONTROL
+      USING_TIMED_PULSE();
+    #endif
+
+    // Pulse start
+    #if HAS_X_STEP
+      STREAM_STEP(X, !INVERT_X_STEP_PIN);
+    #endif
+    #if HAS_Y_STEP
+      STREAM_STEP(Y, !INVERT_Y_STEP_PIN);
+    #endif
+    #if HAS_Z_STEP
+      STREAM_STEP(Z, !INVERT_Z_STEP_PIN);
+    #endif
+    #if HAS_E0_STEP
+      if (TEST(frame.step, E_AXIS)) E_STEP_WRITE(frame.extruder, !INVERT_E_STEP_PIN);
+    #endif
+
+    #if ISR_PULSE_CONTROL
+      START_HIGH_PULSE();
+      AWAIT_HIGH_PULSE();
+    #endif
+
+    // Pulse stop
+    #if HAS_X_STEP
+      STREAM_STEP(X, INVERT_X_STEP_PIN);
+    #endif
+    #if HAS_Y_STEP
+      STREAM_STEP(Y, INVERT_Y_STEP_PIN);
+    #endif
+    #if HAS_Z_STEP
+      STREAM_STEP(Z, INVERT_Z_STEP_PIN);
+    #endif
+    #if HAS_E0_STEP
+      if (TEST(frame.step, E_AXIS)) E_STEP_WRITE(frame.extruder, INVERT_E_STEP_PIN);
+    #endif
+  }
+
+#endif // STEP_STREAM
+
+#if ENABLED(LIN_ADVANCE)
+
+  // Step E for all of LA_steps, a pulse apart
+  void Stepper::la_step_out() {
+    #if ENABLED(LA_MERGE_STEPS)
+      LA_reverse = LA_steps < 0;
+    #endif
+
+    #if ENABLED(STEP_STREAM)
+
+      // A frame for each E step, a pulse apart
+      const uint8_t dir = LA_steps < 0 ? last_direction_bits | _BV(E_AXIS) : last_direction_bits & ~_BV(E_AXIS);
+      for (hal_timer_t event_time = stream_clock; LA_steps; event_time += STREAM_PULSE_TICKS) {
+        stream_push(event_time, _BV(E_AXIS), dir);
+        LA_steps < 0 ? ++LA_steps : --LA_steps;
+      }
+
+    #else
+
+    DIR_WAIT_BEFORE();
+
+    LA_E_DIR(LA_steps < 0);
+
     DIR_WAIT_AFTER();
 
     //const hal_timer_t added_step_ticks = hal_timer_t(ADDED_STEP_TICKS);
@@ -2068,15 +2893,71 @@ uint32_t Stepper::block_phase_isr() {
       #endif
     } // LA_steps
 
-    return interval;
+    #endif // !STEP_STREAM
   }
 
 #endif // LIN_ADVANCE
 
+#if HAS_LA_ISR
+
+  // Timer interrupt for E. LA_steps is set in the main routine
+  uint32_t Stepper::advance_isr() {
+    STEPPER_PROFILE(ADVANCE);
+    uint32_t interval;
+
+    if (LA_use_advance_lead) {
+      if (step_events_completed > decelerate_after && LA_current_adv_steps > LA_final_adv_steps) {
+        LA_steps--;
+        LA_current_adv_steps--;
+        interval = LA_isr_rate;
+      }
+      else if (step_events_completed < decelerate_after && LA_current_adv_steps < LA_max_adv_steps) {
+             //step_events_completed <= (uint32_t)accelerate_until) {
+        LA_steps++;
+        LA_current_adv_steps++;
+        interval = LA_isr_rate;
+      }
+      else
+        interval = LA_isr_rate = LA_ADV_NEVER;
+    }
+    else
+      interval = LA_ADV_NEVER;
+
+    la_step_out();
+
+    return interval;
+  }
+
+#elif ENABLED(LA_MERGE_STEPS)
+
+  // Move the advance to where the step rate puts it, as E steps for the
+  // pulse phase. It only builds up while accelerating and only comes down
+  // while decelerating, within the limits of the block.
+  void Stepper::la_follow(const uint32_t step_rate, const bool accelerating) {
+    uint32_t adv_steps = STEP_MULTIPLY(step_rate, LA_adv_steps_per_rate);
+    if (accelerating) {
+      NOMORE(adv_steps, LA_max_adv_steps);
+      if (adv_steps > LA_current_adv_steps) {
+        LA_steps += adv_steps - LA_current_adv_steps;
+        LA_current_adv_steps = adv_steps;
+      }
+    }
+    else {
+      NOLESS(adv_steps, LA_final_adv_steps);
+      if (adv_steps < LA_current_adv_steps) {
+        LA_steps -= LA_current_adv_steps - adv_steps;
+        LA_current_adv_steps = adv_steps;
+      }
+    }
+  }
+
+#endif
+
 #if ENABLED(INTEGRATED_BABYSTEPPING)
 
   // Timer interrupt for baby-stepping
   uint32_t Stepper::babystepping_isr() {
+    STEPPER_PROFILE(BABYSTEP);
     babystep.task();
     return babystep.has_steps() ? BABYSTEP_TICKS : BABYSTEP_NEVER;
   }
@@ -2312,6 +3193,10 @@ void Stepper::init() {
     E_AXIS_INIT(7);
   #endif
 
+  #if ENABLED(STEPPER_ISR_PROFILE)
+    stepper_profile.init();
+  #endif
+
   #if DISABLED(I2S_STEPPER_STREAM)
     HAL_timer_start(STEP_TIMER_NUM, 122); // Init Stepper ISR to 122 Hz for quick starting
     wake_up();
@@ -2414,6 +3299,13 @@ void Stepper::set_axis_position(const AxisEnum a, const int32_t &v) {
 void Stepper::endstop_triggered(const AxisEnum axis) {
 
   const bool was_enabled = suspend();
+
+  #if ENABLED(INPUT_SHAPING)
+    // The shaped motors stop where they are, short of the commanded position
+    if (shaping_x.impulses) shaping_abort(shaping_x, X_AXIS);
+    if (shaping_y.impulses) shaping_abort(shaping_y, Y_AXIS);
+  #endif
+
   endstops_trigsteps[axis] = (
     #if IS_CORE
       (axis == CORE_AXIS_2
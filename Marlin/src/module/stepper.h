@@ -45,6 +45,9 @@
 
 #include "planner.h"
 #include "stepper/indirection.h"
+#if ENABLED(STEP_STREAM)
+  #include "../HAL/shared/step_stream.h"
+#endif
 #ifdef __AVR__
   #include "speed_lookuptable.h"
 #endif
@@ -233,6 +236,58 @@
 // The minimum allowable frequency for step smoothing will be 1/10 of the maximum nominal frequency (in Hz)
 #define MIN_STEP_ISR_FREQUENCY MAX_STEP_ISR_FREQUENCY_1X
 
+#if ENABLED(INPUT_SHAPING)
+
+  enum ShaperType : uint8_t { SHAPER_ZV, SHAPER_ZVD, SHAPER_MZV, SHAPER_EI };
+
+  typedef struct {
+    ShaperType type;
+    float frequency,  // (Hz) 0 = not shaped
+          zeta;       // Damping ratio
+  } shaping_settings_t;
+
+  #define SHAPING_MAX_IMPULSES 3
+  #define SHAPING_ONE (1L << 24)  // One step, in shaper amplitude units
+
+  typedef uint16_t shaping_index_t;
+
+  // An input-shaped axis: the impulses, the commanded steps they have yet
+  // to replay, and how far the replayed position is ahead of the motor
+  typedef struct {
+    shaping_settings_t settings;
+    uint8_t impulses;                           // 0 = not shaped
+    int32_t amplitude[SHAPING_MAX_IMPULSES];    // Share of a step, adding up to SHAPING_ONE
+    uint32_t delay[SHAPING_MAX_IMPULSES];       // Stepper timer ticks after the commanded step
+    uint32_t step_time[SHAPING_BUFFER_SIZE];    // Commanded steps: timer tick, bit 0 = forward
+    shaping_index_t head,                       // Next free slot
+                    echo[SHAPING_MAX_IMPULSES]; // Next step each delayed impulse replays
+    int32_t error;                              // Replayed minus stepped position, SHAPING_ONE units
+    int8_t direction;                           // Of the DIR pin, 0 until set
+  } shaping_axis_t;
+
+#endif
+
+#if ENABLED(STEP_SCHEDULE)
+
+  // A scheduled ISR call: the timer interval << 3 | log2(steps per ISR)
+  #define SCHEDULE_ENTRY(T, L) (((T) << 3) | (__builtin_ctz(L)))
+
+  // The block phase ISR calls of a block's acceleration and deceleration,
+  // worked out ahead of time by Stepper::schedule_blocks()
+  typedef struct {
+    volatile bool ready;                // Set once the entries are written
+    uint32_t skip;                      // Acceleration calls before the entries, timed by the ISR
+    uint16_t accel, decel;              // Entries of each ramp, in this order
+    uint32_t first,                     // Entry for the initial rate
+             nominal;                   // Entry for the cruise
+    #if DISABLED(S_CURVE_ACCELERATION)
+      uint32_t acc_step_rate;           // Rate at the end of the acceleration
+    #endif
+    uint32_t entry[STEP_SCHEDULE_SIZE];
+  } step_schedule_t;
+
+#endif
+
 //
 // Stepper class definition
 //
@@ -252,6 +307,11 @@ class Stepper {
       static bool initialized;
     #endif
 
+    #if ENABLED(PLANNER_STATS)
+      static uint32_t starved,                // Times the planner ran dry while printing
+                      starved_waiting;        // ...with G-code commands in the queue, so not for want of input
+    #endif
+
   private:
 
     static block_t* current_block;          // A pointer to the block currently being traced
@@ -321,11 +381,17 @@ class Stepper {
       static bool bezier_2nd_half; // If Bézier curve has been initialized or not
     #endif
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_LA_ISR
       static constexpr uint32_t LA_ADV_NEVER = 0xFFFFFFFF;
       static uint32_t nextAdvanceISR, LA_isr_rate;
-      static uint16_t LA_current_adv_steps, LA_final_adv_steps, LA_max_adv_steps; // Copy from current executed block. Needed because current_block is set to NULL "too early".
       static int8_t LA_steps;
+    #elif ENABLED(LA_MERGE_STEPS)
+      static uint32_t LA_adv_steps_per_rate;  // Copy from current executed block
+      static int16_t LA_steps;                // E steps for the pulse phase, advance included
+      static bool LA_reverse;                 // The E DIR pins are set to retract
+    #endif
+    #if ENABLED(LIN_ADVANCE)
+      static uint16_t LA_current_adv_steps, LA_final_adv_steps, LA_max_adv_steps; // Copy from current executed block. Needed because current_block is set to NULL "too early".
       static bool LA_use_advance_lead;
     #endif
 
@@ -334,6 +400,37 @@ class Stepper {
       static uint32_t nextBabystepISR;
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      static constexpr uint32_t SHAPING_NEVER = 0xFFFFFFFF;
+      static uint32_t nextShapingISR,
+                      shaping_clock;        // Stepper timer ticks, the time base of the shaper
+      static shaping_axis_t shaping_x, shaping_y;
+    #endif
+
+    #if ENABLED(STEP_SCHEDULE)
+      static step_schedule_t schedule[BLOCK_BUFFER_SIZE]; // By block buffer index
+      static const uint32_t *schedule_next; // Next entry of the current block
+      static uint32_t schedule_skip;        // Acceleration calls to time before the entries
+      static uint16_t schedule_accel,       // Entries left in each ramp
+                      schedule_decel;
+      static uint32_t schedule_nominal;     // Cruise entry, 0 if not scheduled
+    #endif
+
+    #if ENABLED(STEP_STREAM)
+      static hal_timer_t stream_clock,      // Stepper timer ticks of the producer
+                         stream_last;       // and of its last frame
+      static uint8_t stream_last_dir,       // Directions of the last frame
+                     stream_dir,            // Directions and E stepper set by stream_output()
+                     stream_extruder;
+    #endif
+
+    #if ENABLED(ARC_BLOCKS)
+      static uint16_t arc_chords_left;      // Chords of the current arc after this one
+      static uint32_t arc_events_left;      // Step events left in this chord
+      static xy_long_t arc_radius,          // From the center to the end of this chord (ARC_RADIUS_FRACT_BITS)
+                       arc_vertex;          // End of this chord in steps
+    #endif
+
     static int32_t ticks_nominal;
     #if DISABLED(S_CURVE_ACCELERATION)
       static uint32_t acc_step_rate; // needed for deceleration start point
@@ -382,10 +479,17 @@ class Stepper {
     // The stepper block processing ISR phase
     static uint32_t block_phase_isr();
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_LA_ISR
       // The Linear advance ISR phase
       static uint32_t advance_isr();
       FORCE_INLINE static void initiateLA() { nextAdvanceISR = 0; }
+    #elif ENABLED(LA_MERGE_STEPS)
+      // Linear advance in the pulse and block phases
+      static void la_follow(const uint32_t step_rate, const bool accelerating);
+    #endif
+
+    #if ENABLED(LIN_ADVANCE)
+      static void la_step_out();
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
@@ -399,6 +503,44 @@ class Stepper {
       }
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      // The Input Shaping ISR phase
+      static uint32_t shaping_isr();
+
+      // Change the shaper of X or Y, once the steps of the old one are done
+      static void set_shaping(const AxisEnum axis, const shaping_settings_t &settings);
+      static inline const shaping_settings_t& get_shaping(const AxisEnum axis) {
+        return (axis == X_AXIS ? shaping_x : shaping_y).settings;
+      }
+
+      // Shaped steps are still to be taken after the blocks are done
+      static inline bool is_shaping() {
+        return (shaping_x.impulses && shaping_x.echo[shaping_x.impulses - 1] != shaping_x.head)
+            || (shaping_y.impulses && shaping_y.echo[shaping_y.impulses - 1] != shaping_y.head);
+      }
+    #endif
+
+    #if ENABLED(STEP_SCHEDULE)
+      // Work out the ramps of the blocks the ISR hasn't taken yet. Call from the idle loop.
+      static void schedule_blocks();
+
+      // The trapezoid of a block is about to change - Call with the block marked RECALCULATE
+      static inline void unschedule(const block_t * const block) {
+        schedule[block - planner.block_buffer].ready = false;
+      }
+    #endif
+
+    #if ENABLED(STEP_STREAM)
+      // Run the pulse and block phases ahead, pushing a frame for each pulse
+      static void stream_fill();
+
+      // Set the DIR and pulse the STEP pins of a frame, for HALs playing them back by ISR
+      static void stream_output(const step_frame_t &frame);
+
+      // Frames are still to be played after the blocks are done
+      static inline bool is_streaming() { return !step_stream.empty(); }
+    #endif
+
     // Check if the given block is busy or not - Must not be called from ISR contexts
     static bool is_block_busy(const block_t* const block);
 
@@ -489,10 +631,14 @@ class Stepper {
     FORCE_INLINE static void _set_position(const abce_long_t &spos) { _set_position(spos.a, spos.b, spos.c, spos.e); }
 
     FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, uint8_t* loops) {
+      return calc_timer_interval(step_rate, oversampling_factor, loops);
+    }
+
+    FORCE_INLINE static uint32_t calc_timer_interval(uint32_t step_rate, const uint8_t oversampling, uint8_t* loops) {
       uint32_t timer;
 
       // Scale the frequency, as requested by the caller
-      step_rate <<= oversampling_factor;
+      step_rate <<= oversampling;
 
       uint8_t multistep = 1;
       #if DISABLED(DISABLE_MULTI_STEPPING)
@@ -548,6 +694,24 @@ class Stepper {
       return timer;
     }
 
+    #if ENABLED(STEP_SCHEDULE)
+      static void schedule_block(const block_t * const block, step_schedule_t &s);
+    #endif
+
+    #if ENABLED(STEP_STREAM)
+      static void stream_push(hal_timer_t time, const uint8_t step, const uint8_t dir);
+    #endif
+
+    #if ENABLED(ARC_BLOCKS)
+      static void arc_next_chord();
+    #endif
+
+    #if ENABLED(INPUT_SHAPING)
+      static void shaping_push(shaping_axis_t &s, const bool forward);
+      static int16_t shaping_due(shaping_axis_t &s, uint32_t &interval);
+      static void shaping_abort(shaping_axis_t &s, const AxisEnum axis);
+    #endif
+
     #if ENABLED(S_CURVE_ACCELERATION)
       static void _calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av);
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+from __future__ import division
+
+""" Check a linux_native --bench report against performance limits.
+
+The limits file maps report keys to bounds, with dots reaching into
+nested objects, e.g. { "print_seconds": { "max": 80 },
+"timing.recalculate.avg_ns": { "max": 20000 } }. Every key is printed
+with its value, and the exit status is 1 if any bound is broken.
+"""
+
+import argparse
+import json
+import sys
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('report', help='JSON report written by --bench')
+parser.add_argument('limits', help='JSON file of { "key": { "min": X, "max": Y } }')
+args = parser.parse_args()
+
+with open(args.report) as f:
+    report = json.load(f)
+with open(args.limits) as f:
+    limits = json.load(f)
+
+
+def lookup(data, key):
+    for part in key.split('.'):
+        data = data[part]
+    return data
+
+
+failed = 0
+for key in sorted(limits):
+    bound = limits[key]
+    try:
+        value = lookup(report, key)
+    except (KeyError, TypeError):
+        print('%-32s missing from the report' % key)
+        failed += 1
+        continue
+    problem = ''
+    if 'min' in bound and value < bound['min']:
+        problem = 'below %s' % bound['min']
+    if 'max' in bound and value > bound['max']:
+        problem = 'above %s' % bound['max']
+    print('%-32s %12s  %s' % (key, value, problem.upper() if problem else 'ok'))
+    if problem:
+        failed += 1
+
+sys.exit(1 if failed else 0)
@@ -0,0 +1,136 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+from __future__ import division
+
+""" Encode G-code for the BINARY_MOTION stream.
+
+Writes 'M28 B1' and then the file as binary protocol packets: G1 moves
+packed as fixed-point values, several to a packet, and every other line
+as a text COMMAND packet. A CLOSE packet at the end puts the printer back
+into ASCII mode. Packets are numbered from sync 0, so this suits a
+printer that has just started, or one sent a SYNC packet first.
+
+A host streaming to a real printer sends one packet at a time and waits
+for its "ok<sync>" (or "rs<sync>" to resend). The stream written here
+has no such pacing, which is what linux_native reading stdin needs.
+"""
+
+import argparse
+import struct
+import sys
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('gcode', help='G-code file to encode')
+parser.add_argument('-o', '--output', help='binary stream file (default=stdout)')
+parser.add_argument('-s', '--packet-size', type=int, default=96, help='largest packet payload, the firmware MAX_CMD_SIZE (default=96)')
+args = parser.parse_args()
+
+PROTOCOL_CONTROL, PROTOCOL_MOTION = 0, 2
+CONTROL_CLOSE = 2
+MOTION_MOVES, MOTION_COMMAND = 1, 2
+
+# Move words, their flag bit and decimal places, in packing order
+WORDS = (('X', 0, 3), ('Y', 1, 3), ('Z', 2, 3), ('E', 3, 5), ('F', 4, 3))
+DECIMALS = dict((letter, places) for letter, _, places in WORDS)
+
+
+def fletcher16(data, cs=0):
+    for value in bytearray(data):
+        low = ((cs & 0xFF) + value) % 255
+        cs = ((((cs >> 8) + low) % 255) << 8) | low
+    return cs
+
+
+class Stream(object):
+    def __init__(self, out, packet_size):
+        self.out = out
+        self.packet_size = packet_size
+        self.sync = 0
+        self.moves = b''
+        self.packets = self.move_count = self.commands = 0
+
+    def packet(self, protocol, packet_type, payload=b''):
+        header = struct.pack('<BBH', self.sync, (protocol << 4) | packet_type, len(payload))
+        header += struct.pack('<H', fletcher16(header))
+        self.out.write(struct.pack('<H', 0xB5AD) + header + payload)
+        self.out.write(struct.pack('<H', fletcher16(header + payload)))
+        self.sync = (self.sync + 1) & 0xFF
+        self.packets += 1
+
+    def flush(self):
+        if self.moves:
+            self.packet(PROTOCOL_MOTION, MOTION_MOVES, self.moves)
+            self.moves = b''
+
+    def move(self, packed):
+        if len(self.moves) + len(packed) > self.packet_size:
+            self.flush()
+        self.moves += packed
+        self.move_count += 1
+
+    def command(self, line):
+        payload = line.encode('ascii') + b'\0'
+        if len(payload) > self.packet_size:
+            raise ValueError('line too long for one packet: ' + line)
+        self.flush()
+        self.packet(PROTOCOL_MOTION, MOTION_COMMAND, payload)
+        self.commands += 1
+
+    def close(self):
+        self.flush()
+        self.packet(PROTOCOL_CONTROL, CONTROL_CLOSE)
+
+
+def pack_move(words):
+    """ Return the packed move, or None if the line has to go as text """
+    if len(words) < 2 or words[0] not in ('G1', 'G01'):
+        return None
+    values = {}
+    for word in words[1:]:
+        letter, number = word[0].upper(), word[1:]
+        if letter in values or letter not in 'XYZEF':
+            return None
+        try:
+            values[letter] = float(number)
+        except ValueError:
+            return None
+        fraction = number.split('.', 1)[1] if '.' in number else ''
+        if len(fraction.rstrip('0')) > DECIMALS[letter]:
+            return None  # More precision than the fixed point holds
+    if not any(axis in values for axis in 'XYZ'):
+        return None      # E-only moves stay text, for M209 autoretract
+    flags, data = 0, b''
+    for letter, bit, places in WORDS:
+        if letter in values:
+            fixed = int(round(values[letter] * 10 ** places))
+            if not -0x80000000 <= fixed <= 0x7FFFFFFF:
+                return None
+            flags |= 1 << bit
+            data += struct.pack('<i', fixed)
+    return struct.pack('<B', flags) + data
+
+
+def gcode_lines(path):
+    with open(path) as f:
+        for line in f:
+            line = line.split(';', 1)[0].split('*', 1)[0].strip()
+            if line.startswith('N'):
+                line = line.split(None, 1)[1] if ' ' in line else ''
+            if line:
+                yield line
+
+
+out = open(args.output, 'wb') if args.output else getattr(sys.stdout, 'buffer', sys.stdout)
+out.write(b'M28 B1\n')
+stream = Stream(out, args.packet_size)
+for line in gcode_lines(args.gcode):
+    packed = pack_move(line.split())
+    if packed is None:
+        stream.command(line)
+    else:
+        stream.move(packed)
+stream.close()
+out.flush()
+
+print('%d moves, %d commands in %d packets' % (stream.move_count, stream.commands, stream.packets), file=sys.stderr)
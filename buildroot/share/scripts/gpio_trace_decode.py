@@ -0,0 +1,128 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+from __future__ import division
+
+""" Convert a linux_native binary GPIO trace (all_gpio_log.bin) to CSV or VCD.
+
+CSV rows are "timestamp, pin, event, value" with timestamps in nanoseconds
+and the event numbered as in GpioEvent::Type. VCD output shows every pin as
+a signal: pins that only ever toggle become 1-bit wires, pins written with
+analog values become 16-bit vectors. Mode and direction changes are left
+out of the VCD.
+"""
+
+import argparse
+import struct
+import sys
+
+EVENT_NAMES = ['NOP', 'FALL', 'RISE', 'SET_VALUE', 'SETM', 'SETD']
+NOP, FALL, RISE, SET_VALUE, SETM, SETD = range(6)
+
+HEADER = struct.Struct('<8sIIQQ')
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('trace', help='binary trace written by IOLoggerBinary')
+parser.add_argument('-f', '--format', choices=['csv', 'vcd'], default='csv', help='output format (default=csv)')
+parser.add_argument('-o', '--output', help='output file (default=stdout)')
+args = parser.parse_args()
+
+
+def read_trace(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    magic, version, header_size, data_bytes, dropped = HEADER.unpack_from(data)
+    if magic != b'MRLNGPIO':
+        sys.exit('%s: not a GPIO trace' % path)
+    if version != 1:
+        sys.exit('%s: unsupported trace version %d' % (path, version))
+    if dropped:
+        print('warning: %d events were dropped while tracing' % dropped, file=sys.stderr)
+    return bytearray(data[header_size:header_size + data_bytes])
+
+
+def events(data):
+    """ Yield (timestamp, pin, event, value) for each record """
+    pos, end = 0, len(data)
+    timestamp, pin = 0, 0
+
+    def varint():
+        value, shift = 0, 0
+        while True:
+            b = data[pos + shift // 7]
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                return value, shift // 7
+
+    def unzigzag(v):
+        return (v >> 1) ^ -(v & 1)
+
+    while pos < end:
+        tag = data[pos]
+        pos += 1
+        event = tag & 0x07
+        dt, n = varint()
+        pos += n
+        dp, n = varint()
+        pos += n
+        timestamp += unzigzag(dt)
+        pin += unzigzag(dp)
+        if tag & 0x08:
+            value, n = varint()
+            pos += n
+        else:
+            value = 1 if event == RISE else 0
+        yield timestamp, pin, event, value
+
+
+def write_csv(data, out):
+    for timestamp, pin, event, value in events(data):
+        out.write('%d, %d, %d, %d\n' % (timestamp, pin, event, value))
+
+
+def vcd_id(index):
+    # Printable identifier codes, '!' to '~'
+    code = ''
+    index += 1
+    while index:
+        index, digit = divmod(index - 1, 94)
+        code += chr(33 + digit)
+    return code
+
+
+def write_vcd(data, out):
+    # First pass: which pins change, and which of them carry analog values
+    wide, pins = set(), set()
+    for _, pin, event, value in events(data):
+        if event in (SETM, SETD):
+            continue
+        pins.add(pin)
+        if value > 1:
+            wide.add(pin)
+    ids = dict((pin, vcd_id(i)) for i, pin in enumerate(sorted(pins)))
+
+    out.write('$timescale 1ns $end\n$scope module gpio $end\n')
+    for pin in sorted(pins):
+        out.write('$var wire %d %s pin%d $end\n' % (16 if pin in wide else 1, ids[pin], pin))
+    out.write('$upscope $end\n$enddefinitions $end\n')
+
+    last_time = None
+    for timestamp, pin, event, value in events(data):
+        if event in (SETM, SETD):
+            continue
+        # An ISR can log between another event's timestamp and its slot, VCD needs monotonic time
+        if last_time is not None and timestamp < last_time:
+            timestamp = last_time
+        if timestamp != last_time:
+            out.write('#%d\n' % timestamp)
+            last_time = timestamp
+        if pin in wide:
+            out.write('b{0:b} {1}\n'.format(value, ids[pin]))
+        else:
+            out.write('%d%s\n' % (value & 1, ids[pin]))
+
+
+data = read_trace(args.trace)
+out = open(args.output, 'w') if args.output else sys.stdout
+(write_vcd if args.format == 'vcd' else write_csv)(data, out)
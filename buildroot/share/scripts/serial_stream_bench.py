@@ -0,0 +1,184 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+from __future__ import division
+
+""" Stream G-code to a printer and measure host-to-firmware throughput.
+
+Attaches to a linux_native simulator endpoint (unix:PATH, or the PTY path it
+printed at startup), to any serial device already configured for raw I/O, or
+with exec:COMMAND to a simulator started on stdin/stdout (e.g. with --bench),
+whose input is closed at the end. Lines are sent with the usual "ok" pacing,
+optionally keeping a window of several lines in flight, and the script reports
+lines per second and the send-to-"ok" round-trip latency.
+
+With --credits the lines are numbered and checksummed for SERIAL_CREDITS:
+each is sent as soon as the latest "ok ... C<n>" allows, and a "Resend: <n>"
+sends everything again from line n. --corrupt exercises that path.
+"""
+
+import argparse
+import json
+import os
+import re
+import socket
+import subprocess
+import time
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('endpoint', help='unix:PATH, exec:COMMAND or a tty device path')
+parser.add_argument('gcode', help='G-code file to stream')
+parser.add_argument('-w', '--window', type=int, default=1, help='lines in flight before waiting for an ok (default=1)')
+parser.add_argument('-c', '--credits', action='store_true', help='send numbered lines as far as the SERIAL_CREDITS grants go')
+parser.add_argument('-x', '--corrupt', type=int, default=0, help='with --credits, break the checksum of every Nth line once')
+parser.add_argument('-j', '--json', action='store_true', help='print the report as JSON')
+args = parser.parse_args()
+
+
+class Endpoint(object):
+    def __init__(self, spec):
+        self.process = None
+        if spec.startswith('unix:'):
+            self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            self.sock.connect(spec[5:])
+            self.fd = self.sock.fileno()
+        elif spec.startswith('exec:'):
+            self.process = subprocess.Popen(spec[5:], shell=True, stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+            self.fd = self.process.stdout.fileno()
+        else:
+            import termios
+            import tty
+            self.fd = os.open(spec, os.O_RDWR | os.O_NOCTTY)
+            tty.setraw(self.fd, termios.TCSANOW)
+        self.pending = b''
+
+    def send(self, data):
+        fd = self.process.stdin.fileno() if self.process else self.fd
+        while data:
+            data = data[os.write(fd, data):]
+
+    def close(self):
+        if self.process:
+            self.process.stdin.close()
+            self.process.stdout.read()
+            self.process.wait()
+
+    def readline(self):
+        while b'\n' not in self.pending:
+            chunk = os.read(self.fd, 4096)
+            if not chunk:
+                raise EOFError('printer closed the connection')
+            self.pending += chunk
+        line, self.pending = self.pending.split(b'\n', 1)
+        return line.strip().decode('ascii', 'replace')
+
+
+def gcode_lines(path):
+    with open(path) as f:
+        for line in f:
+            line = line.split(';', 1)[0].strip()
+            if line:
+                yield line
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100.0))]
+
+
+def numbered(n, line):
+    line = 'N%d %s' % (n, line)
+    checksum = 0
+    for c in bytearray(line.encode('ascii')):
+        checksum ^= c
+    return '%s*%d' % (line, checksum)
+
+
+def stream_ok_paced():
+    """ Keep up to --window lines in flight, one "ok" frees one """
+    global errors
+    in_flight = []   # send timestamps, oldest first
+    sent = 0
+    while sent < len(lines) or in_flight:
+        while sent < len(lines) and len(in_flight) < args.window:
+            printer.send((lines[sent] + '\n').encode('ascii'))
+            in_flight.append(time.time())
+            sent += 1
+        reply = printer.readline()
+        if reply.startswith('ok'):
+            rtt.append(time.time() - in_flight.pop(0))
+        elif reply.startswith('Error') or reply.startswith('Resend'):
+            errors += 1
+
+
+def stream_credits():
+    """ Line 0 resets the numbering, after that send up to the granted line """
+    global errors, resends
+    numbered_lines = [numbered(0, 'M110 N0')] + [numbered(n + 1, line) for n, line in enumerate(lines)]
+    last = len(numbered_lines) - 1
+    sent_at = {}
+    corrupted = set()
+    credit = 0       # highest line that may be sent
+    acked = -1       # highest line acknowledged
+    n = 0            # next line to send
+    while acked < last:
+        while n <= min(credit, last):
+            line = numbered_lines[n]
+            if args.corrupt and n and n % args.corrupt == 0 and n not in corrupted:
+                corrupted.add(n)
+                line = line[:-1] + ('0' if line[-1] != '0' else '1')
+            printer.send((line + '\n').encode('ascii'))
+            sent_at[n] = time.time()
+            n += 1
+        reply = printer.readline()
+        if reply.startswith('ok'):
+            words = dict((m.group(1), int(m.group(2))) for m in re.finditer(r' ([NC])(-?\d+)', reply))
+            if 'C' not in words:
+                raise RuntimeError('no credit in "%s", is SERIAL_CREDITS enabled?' % reply)
+            credit = max(credit, words['C'])
+            if 'N' in words and words['N'] > acked:
+                acked = words['N']
+                if acked in sent_at:
+                    rtt.append(time.time() - sent_at[acked])
+        elif reply.startswith('Resend'):
+            n = int(reply.split(':')[1])
+            resends += 1
+        elif reply.startswith('Error'):
+            errors += 1
+
+
+printer = Endpoint(args.endpoint)
+lines = list(gcode_lines(args.gcode))
+rtt = []
+errors = resends = 0
+
+start = time.time()
+if args.credits:
+    stream_credits()
+else:
+    stream_ok_paced()
+elapsed = time.time() - start
+printer.close()
+
+report = {
+    'lines': len(lines),
+    'seconds': elapsed,
+    'lines_per_second': len(lines) / elapsed if elapsed else 0.0,
+    'window': 'credits' if args.credits else args.window,
+    'errors': errors,
+    'resends': resends,
+    'ok_rtt_ms': {
+        'min': min(rtt) * 1000 if rtt else 0.0,
+        'avg': sum(rtt) / len(rtt) * 1000 if rtt else 0.0,
+        'p99': percentile(rtt, 99) * 1000,
+        'max': max(rtt) * 1000 if rtt else 0.0,
+    },
+}
+
+if args.json:
+    print(json.dumps(report, indent=2, sort_keys=True))
+else:
+    print('%d lines in %.3f s: %.1f lines/s (window %s, %d errors, %d resends)' % (report['lines'], report['seconds'], report['lines_per_second'], report['window'], errors, resends))
+    print('ok round-trip ms: min %.3f avg %.3f p99 %.3f max %.3f' % tuple(report['ok_rtt_ms'][k] for k in ('min', 'avg', 'p99', 'max')))
@@ -0,0 +1,139 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+from __future__ import division
+
+""" Run a regression matrix of simulated printers in parallel.
+
+Every profile is a linux_native build of one configuration: either a
+directory holding Configuration.h / Configuration_adv.h, built here with
+PlatformIO in its own copy of the project, or an already built binary
+given as NAME=PATH. Each profile prints each G-code file of the corpus
+headless under virtual time (--bench), in its own working directory, and
+the per-run timing, planner and step fidelity figures are gathered into
+one table and, optionally, one JSON file.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import threading
+from multiprocessing import cpu_count
+from multiprocessing.pool import ThreadPool
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..', '..'))
+CONFIGS = ('Configuration.h', 'Configuration_adv.h', '_Bootscreen.h', '_Statusscreen.h')
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('gcode', nargs='+', help='G-code files of the corpus')
+parser.add_argument('-p', '--profile', action='append', default=[], help='configuration directory to build and run')
+parser.add_argument('-b', '--binary', action='append', default=[], help='NAME=PATH of a built linux_native binary')
+parser.add_argument('-w', '--work', default='sim_fleet', help='work directory (default=sim_fleet)')
+parser.add_argument('-j', '--jobs', type=int, default=cpu_count(), help='parallel builds / runs (default=CPU count)')
+parser.add_argument('-t', '--timeout', type=float, default=600, help='seconds before a run is killed (default=600)')
+parser.add_argument('-o', '--output', help='write all results to this JSON file')
+args = parser.parse_args()
+
+
+def run(command, cwd, stdin=None, stdout=None, timeout=None):
+    """ Run a command, killing it after timeout seconds; return its exit status or None on timeout """
+    proc = subprocess.Popen(command, cwd=cwd, stdin=stdin, stdout=stdout, stderr=subprocess.STDOUT)
+    timer = threading.Timer(timeout, proc.kill) if timeout else None
+    if timer:
+        timer.start()
+    status = proc.wait()
+    if timer:
+        if not timer.is_alive():
+            return None
+        timer.cancel()
+    return status
+
+
+def build(profile):
+    """ Build one configuration in a private copy of the project, return (name, binary or None) """
+    name = os.path.basename(os.path.normpath(profile))
+    project = os.path.join(args.work, name, 'project')
+    if os.path.isdir(project):
+        shutil.rmtree(project)
+    shutil.copytree(os.path.join(ROOT, 'Marlin'), os.path.join(project, 'Marlin'), ignore=shutil.ignore_patterns('.pio'))
+    shutil.copy(os.path.join(ROOT, 'platformio.ini'), project)
+    os.symlink(os.path.join(ROOT, 'buildroot'), os.path.join(project, 'buildroot'))
+    for config in CONFIGS:
+        source = os.path.join(profile, config)
+        if os.path.exists(source):
+            shutil.copy(source, os.path.join(project, 'Marlin'))
+
+    with open(os.path.join(args.work, name, 'build.log'), 'w') as log:
+        status = run(['platformio', 'run', '-e', 'linux_native', '--silent'], project, stdout=log)
+    binary = os.path.join(project, '.pio', 'build', 'linux_native', 'program')
+    return name, binary if status == 0 and os.path.exists(binary) else None
+
+
+def load(path):
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except (IOError, ValueError):
+        return None
+
+
+def simulate(job):
+    """ Print one G-code file on one profile, return the result record """
+    name, binary, gcode = job
+    stem = os.path.splitext(os.path.basename(gcode))[0]
+    cwd = os.path.join(args.work, name, stem)
+    if not os.path.isdir(cwd):
+        os.makedirs(cwd)
+    result = {'profile': name, 'gcode': gcode}
+
+    with open(gcode) as stdin, open(os.path.join(cwd, 'serial.log'), 'w') as stdout:
+        status = run([binary, '--bench', 'bench.json', '--step-stats', 'steps.json'], cwd, stdin, stdout, args.timeout)
+    result['status'] = 'timeout' if status is None else 'ok' if status == 0 else 'exit %d' % status
+
+    bench, steps = load(os.path.join(cwd, 'bench.json')), load(os.path.join(cwd, 'steps.json'))
+    if bench:
+        result.update(bench)
+    if steps:
+        motors = steps['motors'].values()
+        result['missed_deadlines'] = sum(m['missed_deadlines'] for m in motors)
+        result['max_jitter_rms_ns'] = max(m['rms_jitter_ns'] for m in motors)
+        result['step_stats'] = steps
+    if result['status'] == 'ok' and not bench:
+        result['status'] = 'no report'
+    return result
+
+
+if not args.profile and not args.binary:
+    parser.error('give at least one --profile or --binary')
+if not os.path.isdir(args.work):
+    os.makedirs(args.work)
+args.work = os.path.abspath(args.work)
+gcodes = [os.path.abspath(g) for g in args.gcode]
+
+pool = ThreadPool(max(1, args.jobs))
+
+binaries = [tuple(b.split('=', 1)) for b in args.binary]
+for name, binary in pool.map(build, args.profile):
+    if binary:
+        binaries.append((name, binary))
+    else:
+        print('%s: build failed, see %s' % (name, os.path.join(args.work, name, 'build.log')), file=sys.stderr)
+
+jobs = [(name, os.path.abspath(binary), gcode) for name, binary in binaries for gcode in gcodes]
+results = pool.map(simulate, jobs)
+
+print('%-20s %-24s %-9s %10s %8s %8s %6s %10s %8s' % ('profile', 'gcode', 'status', 'print s', 'cpu s', 'blocks', 'starve', 'pos err', 'missed'))
+for r in results:
+    error = max(r['position_error_mm'].values()) if 'position_error_mm' in r else 0
+    print('%-20s %-24s %-9s %10.3f %8.3f %8d %6d %10.6f %8d' % (
+        r['profile'][:20], os.path.basename(r['gcode'])[:24], r['status'], r.get('print_seconds', 0), r.get('cpu_seconds', 0),
+        r.get('blocks', 0), r.get('starvation_events', 0), error, r.get('missed_deadlines', 0)))
+
+if args.output:
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+
+sys.exit(0 if all(r['status'] == 'ok' for r in results) else 1)
@@ -0,0 +1,141 @@
+; linux_native arc benchmark: three layers of arc-welded circles, rounded corners and wiggles
+M302 P1 ; no heating needed, allow cold extrusion
+G21
+G90
+M82
+G28
+G92 E0
+G1 Z0.20 F600
+G0 X130.000 Y110.000 F6000
+G3 X130.000 Y110.000 I-20.000 J0.000 E4.18460 F2400
+G0 X85.000 Y60.000 F6000
+G1 X135.000 Y60.000 E5.84960 F2400
+G3 X140.000 Y65.000 I0.000 J5.000 E6.11114
+G1 X140.000 Y95.000 E7.11014
+G3 X135.000 Y100.000 I-5.000 J0.000 E7.37168
+G1 X85.000 Y100.000 E9.03668
+G3 X80.000 Y95.000 I0.000 J-5.000 E9.29821
+G1 X80.000 Y65.000 E10.29721
+G3 X85.000 Y60.000 I5.000 J0.000 E10.55875
+G0 X80.000 Y120.000 F6000
+G2 X85.000 Y120.000 R2.500 E10.82029 F1800
+G3 X90.000 Y120.000 R2.500 E11.08183 F1800
+G2 X95.000 Y120.000 R2.500 E11.34336 F1800
+G3 X100.000 Y120.000 R2.500 E11.60490 F1800
+G2 X105.000 Y120.000 R2.500 E11.86644 F1800
+G3 X110.000 Y120.000 R2.500 E12.12798 F1800
+G2 X115.000 Y120.000 R2.500 E12.38951 F1800
+G3 X120.000 Y120.000 R2.500 E12.65105 F1800
+G2 X125.000 Y120.000 R2.500 E12.91259 F1800
+G3 X130.000 Y120.000 R2.500 E13.17413 F1800
+G2 X135.000 Y120.000 R2.500 E13.43567 F1800
+G3 X140.000 Y120.000 R2.500 E13.69720 F1800
+G0 X112.000 Y150.000 F6000
+G3 X110.000 Y152.500 I-2.000 J0.000 E13.81489 F2400
+G3 X107.000 Y150.000 I0.000 J-2.500 E13.95874 F2400
+G3 X110.000 Y146.500 I3.000 J0.000 E14.12874 F2400
+G3 X114.000 Y150.000 I0.000 J3.500 E14.32489 F2400
+G3 X110.000 Y154.500 I-4.000 J0.000 E14.54720 F2400
+G3 X105.000 Y150.000 I0.000 J-4.500 E14.79566 F2400
+G3 X110.000 Y144.500 I5.000 J0.000 E15.07028 F2400
+G3 X116.000 Y150.000 I0.000 J5.500 E15.37104 F2400
+G3 X110.000 Y156.500 I-6.000 J0.000 E15.69797 F2400
+G3 X103.000 Y150.000 I0.000 J-6.500 E16.05104 F2400
+G3 X110.000 Y142.500 I7.000 J0.000 E16.43027 F2400
+G3 X118.000 Y150.000 I0.000 J7.500 E16.83565 F2400
+G3 X110.000 Y158.500 I-8.000 J0.000 E17.26719 F2400
+G3 X101.000 Y150.000 I0.000 J-8.500 E17.72488 F2400
+G3 X110.000 Y140.500 I9.000 J0.000 E18.20873 F2400
+G3 X120.000 Y150.000 I-0.000 J9.500 E18.71872 F2400
+M400
+G1 Z0.40 F600
+G0 X130.000 Y110.000 F6000
+G3 X130.000 Y110.000 I-20.000 J0.000 E22.90333 F2400
+G0 X85.000 Y60.000 F6000
+G1 X135.000 Y60.000 E24.56833 F2400
+G3 X140.000 Y65.000 I0.000 J5.000 E24.82986
+G1 X140.000 Y95.000 E25.82886
+G3 X135.000 Y100.000 I-5.000 J0.000 E26.09040
+G1 X85.000 Y100.000 E27.75540
+G3 X80.000 Y95.000 I0.000 J-5.000 E28.01694
+G1 X80.000 Y65.000 E29.01594
+G3 X85.000 Y60.000 I5.000 J0.000 E29.27748
+G0 X80.000 Y120.000 F6000
+G2 X85.000 Y120.000 R2.500 E29.53901 F1800
+G3 X90.000 Y120.000 R2.500 E29.80055 F1800
+G2 X95.000 Y120.000 R2.500 E30.06209 F1800
+G3 X100.000 Y120.000 R2.500 E30.32363 F1800
+G2 X105.000 Y120.000 R2.500 E30.58516 F1800
+G3 X110.000 Y120.000 R2.500 E30.84670 F1800
+G2 X115.000 Y120.000 R2.500 E31.10824 F1800
+G3 X120.000 Y120.000 R2.500 E31.36978 F1800
+G2 X125.000 Y120.000 R2.500 E31.63131 F1800
+G3 X130.000 Y120.000 R2.500 E31.89285 F1800
+G2 X135.000 Y120.000 R2.500 E32.15439 F1800
+G3 X140.000 Y120.000 R2.500 E32.41593 F1800
+G0 X112.000 Y150.000 F6000
+G3 X110.000 Y152.500 I-2.000 J0.000 E32.53362 F2400
+G3 X107.000 Y150.000 I0.000 J-2.500 E32.67746 F2400
+G3 X110.000 Y146.500 I3.000 J0.000 E32.84746 F2400
+G3 X114.000 Y150.000 I0.000 J3.500 E33.04362 F2400
+G3 X110.000 Y154.500 I-4.000 J0.000 E33.26592 F2400
+G3 X105.000 Y150.000 I0.000 J-4.500 E33.51439 F2400
+G3 X110.000 Y144.500 I5.000 J0.000 E33.78900 F2400
+G3 X116.000 Y150.000 I0.000 J5.500 E34.08977 F2400
+G3 X110.000 Y156.500 I-6.000 J0.000 E34.41669 F2400
+G3 X103.000 Y150.000 I0.000 J-6.500 E34.76977 F2400
+G3 X110.000 Y142.500 I7.000 J0.000 E35.14900 F2400
+G3 X118.000 Y150.000 I0.000 J7.500 E35.55438 F2400
+G3 X110.000 Y158.500 I-8.000 J0.000 E35.98592 F2400
+G3 X101.000 Y150.000 I0.000 J-8.500 E36.44361 F2400
+G3 X110.000 Y140.500 I9.000 J0.000 E36.92745 F2400
+G3 X120.000 Y150.000 I-0.000 J9.500 E37.43745 F2400
+M400
+G1 Z0.60 F600
+G0 X130.000 Y110.000 F6000
+G3 X130.000 Y110.000 I-20.000 J0.000 E41.62205 F2400
+G0 X85.000 Y60.000 F6000
+G1 X135.000 Y60.000 E43.28705 F2400
+G3 X140.000 Y65.000 I0.000 J5.000 E43.54859
+G1 X140.000 Y95.000 E44.54759
+G3 X135.000 Y100.000 I-5.000 J0.000 E44.80913
+G1 X85.000 Y100.000 E46.47413
+G3 X80.000 Y95.000 I0.000 J-5.000 E46.73566
+G1 X80.000 Y65.000 E47.73466
+G3 X85.000 Y60.000 I5.000 J0.000 E47.99620
+G0 X80.000 Y120.000 F6000
+G2 X85.000 Y120.000 R2.500 E48.25774 F1800
+G3 X90.000 Y120.000 R2.500 E48.51928 F1800
+G2 X95.000 Y120.000 R2.500 E48.78081 F1800
+G3 X100.000 Y120.000 R2.500 E49.04235 F1800
+G2 X105.000 Y120.000 R2.500 E49.30389 F1800
+G3 X110.000 Y120.000 R2.500 E49.56543 F1800
+G2 X115.000 Y120.000 R2.500 E49.82696 F1800
+G3 X120.000 Y120.000 R2.500 E50.08850 F1800
+G2 X125.000 Y120.000 R2.500 E50.35004 F1800
+G3 X130.000 Y120.000 R2.500 E50.61158 F1800
+G2 X135.000 Y120.000 R2.500 E50.87311 F1800
+G3 X140.000 Y120.000 R2.500 E51.13465 F1800
+G0 X112.000 Y150.000 F6000
+G3 X110.000 Y152.500 I-2.000 J0.000 E51.25234 F2400
+G3 X107.000 Y150.000 I0.000 J-2.500 E51.39619 F2400
+G3 X110.000 Y146.500 I3.000 J0.000 E51.56619 F2400
+G3 X114.000 Y150.000 I0.000 J3.500 E51.76234 F2400
+G3 X110.000 Y154.500 I-4.000 J0.000 E51.98465 F2400
+G3 X105.000 Y150.000 I0.000 J-4.500 E52.23311 F2400
+G3 X110.000 Y144.500 I5.000 J0.000 E52.50772 F2400
+G3 X116.000 Y150.000 I0.000 J5.500 E52.80849 F2400
+G3 X110.000 Y156.500 I-6.000 J0.000 E53.13541 F2400
+G3 X103.000 Y150.000 I0.000 J-6.500 E53.48849 F2400
+G3 X110.000 Y142.500 I7.000 J0.000 E53.86772 F2400
+G3 X118.000 Y150.000 I0.000 J7.500 E54.27310 F2400
+G3 X110.000 Y158.500 I-8.000 J0.000 E54.70464 F2400
+G3 X101.000 Y150.000 I0.000 J-8.500 E55.16233 F2400
+G3 X110.000 Y140.500 I9.000 J0.000 E55.64618 F2400
+G3 X120.000 Y150.000 I-0.000 J9.500 E56.15617 F2400
+M400
+G0 X130.000 Y110.000 F6000
+G2 X130.000 Y110.000 Z5.000 I-20.000 J0.000 F3000
+G2 X110.000 Y90.000 I-20.000 J0.000 E55.15617 F3000
+G1 X10 Y10 F6000
+M400
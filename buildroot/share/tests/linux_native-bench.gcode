@@ -0,0 +1,789 @@
+; linux_native benchmark: three layers of perimeters, infill and fine curves
+M302 P1 ; no heating needed, allow cold extrusion
+G21
+G90
+M82
+G28
+G92 E0
+G1 Z0.20 F600
+G1 E-1.00000 F2400
+G0 X130.000 Y110.000 F6000
+G1 E0.00000 F2400
+G1 X129.975 Y110.997 E0.03291 F2400
+G1 X129.901 Y111.991 E0.06582 F2400
+G1 X129.777 Y112.981 E0.09873 F2400
+G1 X129.603 Y113.963 E0.13163 F2400
+G1 X129.382 Y114.935 E0.16454 F2400
+G1 X129.111 Y115.895 E0.19745 F2400
+G1 X128.794 Y116.840 E0.23036 F2400
+G1 X128.430 Y117.769 E0.26327 F2400
+G1 X128.019 Y118.678 E0.29618 F2400
+G1 X127.564 Y119.565 E0.32909 F2400
+G1 X127.066 Y120.429 E0.36199 F2400
+G1 X126.525 Y121.266 E0.39490 F2400
+G1 X125.943 Y122.076 E0.42781 F2400
+G1 X125.321 Y122.856 E0.46072 F2400
+G1 X124.661 Y123.603 E0.49363 F2400
+G1 X123.965 Y124.317 E0.52654 F2400
+G1 X123.234 Y124.996 E0.55944 F2400
+G1 X122.470 Y125.637 E0.59235 F2400
+G1 X121.675 Y126.239 E0.62526 F2400
+G1 X120.851 Y126.801 E0.65817 F2400
+G1 X120.000 Y127.321 E0.69108 F2400
+G1 X119.124 Y127.797 E0.72399 F2400
+G1 X118.226 Y128.230 E0.75690 F2400
+G1 X117.307 Y128.617 E0.78980 F2400
+G1 X116.370 Y128.959 E0.82271 F2400
+G1 X115.417 Y129.252 E0.85562 F2400
+G1 X114.450 Y129.499 E0.88853 F2400
+G1 X113.473 Y129.696 E0.92144 F2400
+G1 X112.487 Y129.845 E0.95435 F2400
+G1 X111.495 Y129.944 E0.98726 F2400
+G1 X110.499 Y129.994 E1.02016 F2400
+G1 X109.501 Y129.994 E1.05307 F2400
+G1 X108.505 Y129.944 E1.08598 F2400
+G1 X107.513 Y129.845 E1.11889 F2400
+G1 X106.527 Y129.696 E1.15180 F2400
+G1 X105.550 Y129.499 E1.18471 F2400
+G1 X104.583 Y129.252 E1.21761 F2400
+G1 X103.630 Y128.959 E1.25052 F2400
+G1 X102.693 Y128.617 E1.28343 F2400
+G1 X101.774 Y128.230 E1.31634 F2400
+G1 X100.876 Y127.797 E1.34925 F2400
+G1 X100.000 Y127.321 E1.38216 F2400
+G1 X99.149 Y126.801 E1.41507 F2400
+G1 X98.325 Y126.239 E1.44797 F2400
+G1 X97.530 Y125.637 E1.48088 F2400
+G1 X96.766 Y124.996 E1.51379 F2400
+G1 X96.035 Y124.317 E1.54670 F2400
+G1 X95.339 Y123.603 E1.57961 F2400
+G1 X94.679 Y122.856 E1.61252 F2400
+G1 X94.057 Y122.076 E1.64543 F2400
+G1 X93.475 Y121.266 E1.67833 F2400
+G1 X92.934 Y120.429 E1.71124 F2400
+G1 X92.436 Y119.565 E1.74415 F2400
+G1 X91.981 Y118.678 E1.77706 F2400
+G1 X91.570 Y117.769 E1.80997 F2400
+G1 X91.206 Y116.840 E1.84288 F2400
+G1 X90.889 Y115.895 E1.87579 F2400
+G1 X90.618 Y114.935 E1.90869 F2400
+G1 X90.397 Y113.963 E1.94160 F2400
+G1 X90.223 Y112.981 E1.97451 F2400
+G1 X90.099 Y111.991 E2.00742 F2400
+G1 X90.025 Y110.997 E2.04033 F2400
+G1 X90.000 Y110.000 E2.07324 F2400
+G1 X90.025 Y109.003 E2.10614 F2400
+G1 X90.099 Y108.009 E2.13905 F2400
+G1 X90.223 Y107.019 E2.17196 F2400
+G1 X90.397 Y106.037 E2.20487 F2400
+G1 X90.618 Y105.065 E2.23778 F2400
+G1 X90.889 Y104.105 E2.27069 F2400
+G1 X91.206 Y103.160 E2.30360 F2400
+G1 X91.570 Y102.231 E2.33650 F2400
+G1 X91.981 Y101.322 E2.36941 F2400
+G1 X92.436 Y100.435 E2.40232 F2400
+G1 X92.934 Y99.571 E2.43523 F2400
+G1 X93.475 Y98.734 E2.46814 F2400
+G1 X94.057 Y97.924 E2.50105 F2400
+G1 X94.679 Y97.144 E2.53396 F2400
+G1 X95.339 Y96.397 E2.56686 F2400
+G1 X96.035 Y95.683 E2.59977 F2400
+G1 X96.766 Y95.004 E2.63268 F2400
+G1 X97.530 Y94.363 E2.66559 F2400
+G1 X98.325 Y93.761 E2.69850 F2400
+G1 X99.149 Y93.199 E2.73141 F2400
+G1 X100.000 Y92.679 E2.76432 F2400
+G1 X100.876 Y92.203 E2.79722 F2400
+G1 X101.774 Y91.770 E2.83013 F2400
+G1 X102.693 Y91.383 E2.86304 F2400
+G1 X103.630 Y91.041 E2.89595 F2400
+G1 X104.583 Y90.748 E2.92886 F2400
+G1 X105.550 Y90.501 E2.96177 F2400
+G1 X106.527 Y90.304 E2.99467 F2400
+G1 X107.513 Y90.155 E3.02758 F2400
+G1 X108.505 Y90.056 E3.06049 F2400
+G1 X109.501 Y90.006 E3.09340 F2400
+G1 X110.499 Y90.006 E3.12631 F2400
+G1 X111.495 Y90.056 E3.15922 F2400
+G1 X112.487 Y90.155 E3.19213 F2400
+G1 X113.473 Y90.304 E3.22503 F2400
+G1 X114.450 Y90.501 E3.25794 F2400
+G1 X115.417 Y90.748 E3.29085 F2400
+G1 X116.370 Y91.041 E3.32376 F2400
+G1 X117.307 Y91.383 E3.35667 F2400
+G1 X118.226 Y91.770 E3.38958 F2400
+G1 X119.124 Y92.203 E3.42249 F2400
+G1 X120.000 Y92.679 E3.45539 F2400
+G1 X120.851 Y93.199 E3.48830 F2400
+G1 X121.675 Y93.761 E3.52121 F2400
+G1 X122.470 Y94.363 E3.55412 F2400
+G1 X123.234 Y95.004 E3.58703 F2400
+G1 X123.965 Y95.683 E3.61994 F2400
+G1 X124.661 Y96.397 E3.65284 F2400
+G1 X125.321 Y97.144 E3.68575 F2400
+G1 X125.943 Y97.924 E3.71866 F2400
+G1 X126.525 Y98.734 E3.75157 F2400
+G1 X127.066 Y99.571 E3.78448 F2400
+G1 X127.564 Y100.435 E3.81739 F2400
+G1 X128.019 Y101.322 E3.85030 F2400
+G1 X128.430 Y102.231 E3.88320 F2400
+G1 X128.794 Y103.160 E3.91611 F2400
+G1 X129.111 Y104.105 E3.94902 F2400
+G1 X129.382 Y105.065 E3.98193 F2400
+G1 X129.603 Y106.037 E4.01484 F2400
+G1 X129.777 Y107.019 E4.04775 F2400
+G1 X129.901 Y108.009 E4.08066 F2400
+G1 X129.975 Y109.003 E4.11356 F2400
+G1 X130.000 Y110.000 E4.14647 F2400
+G1 E3.14647 F2400
+G0 X98.000 Y98.000 F6000
+G1 E4.14647 F2400
+G1 X122.000 Y98.000 E4.93847 F3000
+G1 X122.000 Y122.000 E5.73047 F3000
+G1 X98.000 Y122.000 E6.52247 F3000
+G1 X98.000 Y98.000 E7.31447 F3000
+G1 E6.31447 F2400
+G0 X99.000 Y98.500 F6000
+G1 E7.31447 F2400
+G1 X99.000 Y121.500 E8.07347 F4800
+G1 X101.000 Y121.500 E8.13947 F4800
+G1 X101.000 Y98.500 E8.89847 F4800
+G1 X103.000 Y98.500 E8.96447 F4800
+G1 X103.000 Y121.500 E9.72347 F4800
+G1 X105.000 Y121.500 E9.78947 F4800
+G1 X105.000 Y98.500 E10.54847 F4800
+G1 X107.000 Y98.500 E10.61447 F4800
+G1 X107.000 Y121.500 E11.37347 F4800
+G1 X109.000 Y121.500 E11.43947 F4800
+G1 X109.000 Y98.500 E12.19847 F4800
+G1 X111.000 Y98.500 E12.26447 F4800
+G1 X111.000 Y121.500 E13.02347 F4800
+G1 X113.000 Y121.500 E13.08947 F4800
+G1 X113.000 Y98.500 E13.84847 F4800
+G1 X115.000 Y98.500 E13.91447 F4800
+G1 X115.000 Y121.500 E14.67347 F4800
+G1 X117.000 Y121.500 E14.73947 F4800
+G1 X117.000 Y98.500 E15.49847 F4800
+G1 X119.000 Y98.500 E15.56447 F4800
+G1 X119.000 Y121.500 E16.32347 F4800
+G1 X121.000 Y121.500 E16.38947 F4800
+G1 X121.000 Y98.500 E17.14847 F4800
+G1 E16.14847 F2400
+G0 X143.000 Y110.000 F6000
+G1 E17.14847 F2400
+G1 X142.993 Y110.200 E17.15509 F1800
+G1 X142.973 Y110.400 E17.16170 F1800
+G1 X142.940 Y110.598 E17.16832 F1800
+G1 X142.893 Y110.793 E17.17494 F1800
+G1 X142.834 Y110.984 E17.18155 F1800
+G1 X142.762 Y111.171 E17.18817 F1800
+G1 X142.678 Y111.353 E17.19479 F1800
+G1 X142.581 Y111.529 E17.20140 F1800
+G1 X142.473 Y111.698 E17.20802 F1800
+G1 X142.354 Y111.859 E17.21463 F1800
+G1 X142.225 Y112.012 E17.22125 F1800
+G1 X142.086 Y112.156 E17.22787 F1800
+G1 X141.937 Y112.291 E17.23448 F1800
+G1 X141.780 Y112.415 E17.24110 F1800
+G1 X141.614 Y112.529 E17.24772 F1800
+G1 X141.442 Y112.631 E17.25433 F1800
+G1 X141.263 Y112.721 E17.26095 F1800
+G1 X141.078 Y112.800 E17.26756 F1800
+G1 X140.889 Y112.865 E17.27418 F1800
+G1 X140.695 Y112.918 E17.28080 F1800
+G1 X140.499 Y112.958 E17.28741 F1800
+G1 X140.300 Y112.985 E17.29403 F1800
+G1 X140.100 Y112.998 E17.30064 F1800
+G1 X139.900 Y112.998 E17.30726 F1800
+G1 X139.700 Y112.985 E17.31388 F1800
+G1 X139.501 Y112.958 E17.32049 F1800
+G1 X139.305 Y112.918 E17.32711 F1800
+G1 X139.111 Y112.865 E17.33373 F1800
+G1 X138.922 Y112.800 E17.34034 F1800
+G1 X138.737 Y112.721 E17.34696 F1800
+G1 X138.558 Y112.631 E17.35357 F1800
+G1 X138.386 Y112.529 E17.36019 F1800
+G1 X138.220 Y112.415 E17.36681 F1800
+G1 X138.063 Y112.291 E17.37342 F1800
+G1 X137.914 Y112.156 E17.38004 F1800
+G1 X137.775 Y112.012 E17.38665 F1800
+G1 X137.646 Y111.859 E17.39327 F1800
+G1 X137.527 Y111.698 E17.39989 F1800
+G1 X137.419 Y111.529 E17.40650 F1800
+G1 X137.322 Y111.353 E17.41312 F1800
+G1 X137.238 Y111.171 E17.41974 F1800
+G1 X137.166 Y110.984 E17.42635 F1800
+G1 X137.107 Y110.793 E17.43297 F1800
+G1 X137.060 Y110.598 E17.43958 F1800
+G1 X137.027 Y110.400 E17.44620 F1800
+G1 X137.007 Y110.200 E17.45282 F1800
+G1 X137.000 Y110.000 E17.45943 F1800
+G1 X137.007 Y109.800 E17.46605 F1800
+G1 X137.027 Y109.600 E17.47266 F1800
+G1 X137.060 Y109.402 E17.47928 F1800
+G1 X137.107 Y109.207 E17.48590 F1800
+G1 X137.166 Y109.016 E17.49251 F1800
+G1 X137.238 Y108.829 E17.49913 F1800
+G1 X137.322 Y108.647 E17.50575 F1800
+G1 X137.419 Y108.471 E17.51236 F1800
+G1 X137.527 Y108.302 E17.51898 F1800
+G1 X137.646 Y108.141 E17.52559 F1800
+G1 X137.775 Y107.988 E17.53221 F1800
+G1 X137.914 Y107.844 E17.53883 F1800
+G1 X138.063 Y107.709 E17.54544 F1800
+G1 X138.220 Y107.585 E17.55206 F1800
+G1 X138.386 Y107.471 E17.55867 F1800
+G1 X138.558 Y107.369 E17.56529 F1800
+G1 X138.737 Y107.279 E17.57191 F1800
+G1 X138.922 Y107.200 E17.57852 F1800
+G1 X139.111 Y107.135 E17.58514 F1800
+G1 X139.305 Y107.082 E17.59176 F1800
+G1 X139.501 Y107.042 E17.59837 F1800
+G1 X139.700 Y107.015 E17.60499 F1800
+G1 X139.900 Y107.002 E17.61160 F1800
+G1 X140.100 Y107.002 E17.61822 F1800
+G1 X140.300 Y107.015 E17.62484 F1800
+G1 X140.499 Y107.042 E17.63145 F1800
+G1 X140.695 Y107.082 E17.63807 F1800
+G1 X140.889 Y107.135 E17.64469 F1800
+G1 X141.078 Y107.200 E17.65130 F1800
+G1 X141.263 Y107.279 E17.65792 F1800
+G1 X141.442 Y107.369 E17.66453 F1800
+G1 X141.614 Y107.471 E17.67115 F1800
+G1 X141.780 Y107.585 E17.67777 F1800
+G1 X141.937 Y107.709 E17.68438 F1800
+G1 X142.086 Y107.844 E17.69100 F1800
+G1 X142.225 Y107.988 E17.69761 F1800
+G1 X142.354 Y108.141 E17.70423 F1800
+G1 X142.473 Y108.302 E17.71085 F1800
+G1 X142.581 Y108.471 E17.71746 F1800
+G1 X142.678 Y108.647 E17.72408 F1800
+G1 X142.762 Y108.829 E17.73070 F1800
+G1 X142.834 Y109.016 E17.73731 F1800
+G1 X142.893 Y109.207 E17.74393 F1800
+G1 X142.940 Y109.402 E17.75054 F1800
+G1 X142.973 Y109.600 E17.75716 F1800
+G1 X142.993 Y109.800 E17.76378 F1800
+G1 X143.000 Y110.000 E17.77039 F1800
+G1 Z0.40 F600
+G1 E16.77039 F2400
+G0 X130.000 Y110.000 F6000
+G1 E17.77039 F2400
+G1 X129.975 Y110.997 E17.80330 F2400
+G1 X129.901 Y111.991 E17.83621 F2400
+G1 X129.777 Y112.981 E17.86912 F2400
+G1 X129.603 Y113.963 E17.90203 F2400
+G1 X129.382 Y114.935 E17.93493 F2400
+G1 X129.111 Y115.895 E17.96784 F2400
+G1 X128.794 Y116.840 E18.00075 F2400
+G1 X128.430 Y117.769 E18.03366 F2400
+G1 X128.019 Y118.678 E18.06657 F2400
+G1 X127.564 Y119.565 E18.09948 F2400
+G1 X127.066 Y120.429 E18.13239 F2400
+G1 X126.525 Y121.266 E18.16529 F2400
+G1 X125.943 Y122.076 E18.19820 F2400
+G1 X125.321 Y122.856 E18.23111 F2400
+G1 X124.661 Y123.603 E18.26402 F2400
+G1 X123.965 Y124.317 E18.29693 F2400
+G1 X123.234 Y124.996 E18.32984 F2400
+G1 X122.470 Y125.637 E18.36275 F2400
+G1 X121.675 Y126.239 E18.39565 F2400
+G1 X120.851 Y126.801 E18.42856 F2400
+G1 X120.000 Y127.321 E18.46147 F2400
+G1 X119.124 Y127.797 E18.49438 F2400
+G1 X118.226 Y128.230 E18.52729 F2400
+G1 X117.307 Y128.617 E18.56020 F2400
+G1 X116.370 Y128.959 E18.59311 F2400
+G1 X115.417 Y129.252 E18.62601 F2400
+G1 X114.450 Y129.499 E18.65892 F2400
+G1 X113.473 Y129.696 E18.69183 F2400
+G1 X112.487 Y129.845 E18.72474 F2400
+G1 X111.495 Y129.944 E18.75765 F2400
+G1 X110.499 Y129.994 E18.79056 F2400
+G1 X109.501 Y129.994 E18.82346 F2400
+G1 X108.505 Y129.944 E18.85637 F2400
+G1 X107.513 Y129.845 E18.88928 F2400
+G1 X106.527 Y129.696 E18.92219 F2400
+G1 X105.550 Y129.499 E18.95510 F2400
+G1 X104.583 Y129.252 E18.98801 F2400
+G1 X103.630 Y128.959 E19.02092 F2400
+G1 X102.693 Y128.617 E19.05382 F2400
+G1 X101.774 Y128.230 E19.08673 F2400
+G1 X100.876 Y127.797 E19.11964 F2400
+G1 X100.000 Y127.321 E19.15255 F2400
+G1 X99.149 Y126.801 E19.18546 F2400
+G1 X98.325 Y126.239 E19.21837 F2400
+G1 X97.530 Y125.637 E19.25128 F2400
+G1 X96.766 Y124.996 E19.28418 F2400
+G1 X96.035 Y124.317 E19.31709 F2400
+G1 X95.339 Y123.603 E19.35000 F2400
+G1 X94.679 Y122.856 E19.38291 F2400
+G1 X94.057 Y122.076 E19.41582 F2400
+G1 X93.475 Y121.266 E19.44873 F2400
+G1 X92.934 Y120.429 E19.48163 F2400
+G1 X92.436 Y119.565 E19.51454 F2400
+G1 X91.981 Y118.678 E19.54745 F2400
+G1 X91.570 Y117.769 E19.58036 F2400
+G1 X91.206 Y116.840 E19.61327 F2400
+G1 X90.889 Y115.895 E19.64618 F2400
+G1 X90.618 Y114.935 E19.67909 F2400
+G1 X90.397 Y113.963 E19.71199 F2400
+G1 X90.223 Y112.981 E19.74490 F2400
+G1 X90.099 Y111.991 E19.77781 F2400
+G1 X90.025 Y110.997 E19.81072 F2400
+G1 X90.000 Y110.000 E19.84363 F2400
+G1 X90.025 Y109.003 E19.87654 F2400
+G1 X90.099 Y108.009 E19.90945 F2400
+G1 X90.223 Y107.019 E19.94235 F2400
+G1 X90.397 Y106.037 E19.97526 F2400
+G1 X90.618 Y105.065 E20.00817 F2400
+G1 X90.889 Y104.105 E20.04108 F2400
+G1 X91.206 Y103.160 E20.07399 F2400
+G1 X91.570 Y102.231 E20.10690 F2400
+G1 X91.981 Y101.322 E20.13981 F2400
+G1 X92.436 Y100.435 E20.17271 F2400
+G1 X92.934 Y99.571 E20.20562 F2400
+G1 X93.475 Y98.734 E20.23853 F2400
+G1 X94.057 Y97.924 E20.27144 F2400
+G1 X94.679 Y97.144 E20.30435 F2400
+G1 X95.339 Y96.397 E20.33726 F2400
+G1 X96.035 Y95.683 E20.37016 F2400
+G1 X96.766 Y95.004 E20.40307 F2400
+G1 X97.530 Y94.363 E20.43598 F2400
+G1 X98.325 Y93.761 E20.46889 F2400
+G1 X99.149 Y93.199 E20.50180 F2400
+G1 X100.000 Y92.679 E20.53471 F2400
+G1 X100.876 Y92.203 E20.56762 F2400
+G1 X101.774 Y91.770 E20.60052 F2400
+G1 X102.693 Y91.383 E20.63343 F2400
+G1 X103.630 Y91.041 E20.66634 F2400
+G1 X104.583 Y90.748 E20.69925 F2400
+G1 X105.550 Y90.501 E20.73216 F2400
+G1 X106.527 Y90.304 E20.76507 F2400
+G1 X107.513 Y90.155 E20.79798 F2400
+G1 X108.505 Y90.056 E20.83088 F2400
+G1 X109.501 Y90.006 E20.86379 F2400
+G1 X110.499 Y90.006 E20.89670 F2400
+G1 X111.495 Y90.056 E20.92961 F2400
+G1 X112.487 Y90.155 E20.96252 F2400
+G1 X113.473 Y90.304 E20.99543 F2400
+G1 X114.450 Y90.501 E21.02833 F2400
+G1 X115.417 Y90.748 E21.06124 F2400
+G1 X116.370 Y91.041 E21.09415 F2400
+G1 X117.307 Y91.383 E21.12706 F2400
+G1 X118.226 Y91.770 E21.15997 F2400
+G1 X119.124 Y92.203 E21.19288 F2400
+G1 X120.000 Y92.679 E21.22579 F2400
+G1 X120.851 Y93.199 E21.25869 F2400
+G1 X121.675 Y93.761 E21.29160 F2400
+G1 X122.470 Y94.363 E21.32451 F2400
+G1 X123.234 Y95.004 E21.35742 F2400
+G1 X123.965 Y95.683 E21.39033 F2400
+G1 X124.661 Y96.397 E21.42324 F2400
+G1 X125.321 Y97.144 E21.45615 F2400
+G1 X125.943 Y97.924 E21.48905 F2400
+G1 X126.525 Y98.734 E21.52196 F2400
+G1 X127.066 Y99.571 E21.55487 F2400
+G1 X127.564 Y100.435 E21.58778 F2400
+G1 X128.019 Y101.322 E21.62069 F2400
+G1 X128.430 Y102.231 E21.65360 F2400
+G1 X128.794 Y103.160 E21.68651 F2400
+G1 X129.111 Y104.105 E21.71941 F2400
+G1 X129.382 Y105.065 E21.75232 F2400
+G1 X129.603 Y106.037 E21.78523 F2400
+G1 X129.777 Y107.019 E21.81814 F2400
+G1 X129.901 Y108.009 E21.85105 F2400
+G1 X129.975 Y109.003 E21.88396 F2400
+G1 X130.000 Y110.000 E21.91686 F2400
+G1 E20.91686 F2400
+G0 X98.000 Y98.000 F6000
+G1 E21.91686 F2400
+G1 X122.000 Y98.000 E22.70886 F3000
+G1 X122.000 Y122.000 E23.50086 F3000
+G1 X98.000 Y122.000 E24.29286 F3000
+G1 X98.000 Y98.000 E25.08486 F3000
+G1 E24.08486 F2400
+G0 X98.500 Y99.000 F6000
+G1 E25.08486 F2400
+G1 X121.500 Y99.000 E25.84386 F4800
+G1 X121.500 Y101.000 E25.90986 F4800
+G1 X98.500 Y101.000 E26.66886 F4800
+G1 X98.500 Y103.000 E26.73486 F4800
+G1 X121.500 Y103.000 E27.49386 F4800
+G1 X121.500 Y105.000 E27.55986 F4800
+G1 X98.500 Y105.000 E28.31886 F4800
+G1 X98.500 Y107.000 E28.38486 F4800
+G1 X121.500 Y107.000 E29.14386 F4800
+G1 X121.500 Y109.000 E29.20986 F4800
+G1 X98.500 Y109.000 E29.96886 F4800
+G1 X98.500 Y111.000 E30.03486 F4800
+G1 X121.500 Y111.000 E30.79386 F4800
+G1 X121.500 Y113.000 E30.85986 F4800
+G1 X98.500 Y113.000 E31.61886 F4800
+G1 X98.500 Y115.000 E31.68486 F4800
+G1 X121.500 Y115.000 E32.44386 F4800
+G1 X121.500 Y117.000 E32.50986 F4800
+G1 X98.500 Y117.000 E33.26886 F4800
+G1 X98.500 Y119.000 E33.33486 F4800
+G1 X121.500 Y119.000 E34.09386 F4800
+G1 X121.500 Y121.000 E34.15986 F4800
+G1 X98.500 Y121.000 E34.91886 F4800
+G1 E33.91886 F2400
+G0 X143.000 Y110.000 F6000
+G1 E34.91886 F2400
+G1 X142.993 Y110.200 E34.92548 F1800
+G1 X142.973 Y110.400 E34.93210 F1800
+G1 X142.940 Y110.598 E34.93871 F1800
+G1 X142.893 Y110.793 E34.94533 F1800
+G1 X142.834 Y110.984 E34.95195 F1800
+G1 X142.762 Y111.171 E34.95856 F1800
+G1 X142.678 Y111.353 E34.96518 F1800
+G1 X142.581 Y111.529 E34.97179 F1800
+G1 X142.473 Y111.698 E34.97841 F1800
+G1 X142.354 Y111.859 E34.98503 F1800
+G1 X142.225 Y112.012 E34.99164 F1800
+G1 X142.086 Y112.156 E34.99826 F1800
+G1 X141.937 Y112.291 E35.00488 F1800
+G1 X141.780 Y112.415 E35.01149 F1800
+G1 X141.614 Y112.529 E35.01811 F1800
+G1 X141.442 Y112.631 E35.02472 F1800
+G1 X141.263 Y112.721 E35.03134 F1800
+G1 X141.078 Y112.800 E35.03796 F1800
+G1 X140.889 Y112.865 E35.04457 F1800
+G1 X140.695 Y112.918 E35.05119 F1800
+G1 X140.499 Y112.958 E35.05780 F1800
+G1 X140.300 Y112.985 E35.06442 F1800
+G1 X140.100 Y112.998 E35.07104 F1800
+G1 X139.900 Y112.998 E35.07765 F1800
+G1 X139.700 Y112.985 E35.08427 F1800
+G1 X139.501 Y112.958 E35.09089 F1800
+G1 X139.305 Y112.918 E35.09750 F1800
+G1 X139.111 Y112.865 E35.10412 F1800
+G1 X138.922 Y112.800 E35.11073 F1800
+G1 X138.737 Y112.721 E35.11735 F1800
+G1 X138.558 Y112.631 E35.12397 F1800
+G1 X138.386 Y112.529 E35.13058 F1800
+G1 X138.220 Y112.415 E35.13720 F1800
+G1 X138.063 Y112.291 E35.14381 F1800
+G1 X137.914 Y112.156 E35.15043 F1800
+G1 X137.775 Y112.012 E35.15705 F1800
+G1 X137.646 Y111.859 E35.16366 F1800
+G1 X137.527 Y111.698 E35.17028 F1800
+G1 X137.419 Y111.529 E35.17690 F1800
+G1 X137.322 Y111.353 E35.18351 F1800
+G1 X137.238 Y111.171 E35.19013 F1800
+G1 X137.166 Y110.984 E35.19674 F1800
+G1 X137.107 Y110.793 E35.20336 F1800
+G1 X137.060 Y110.598 E35.20998 F1800
+G1 X137.027 Y110.400 E35.21659 F1800
+G1 X137.007 Y110.200 E35.22321 F1800
+G1 X137.000 Y110.000 E35.22982 F1800
+G1 X137.007 Y109.800 E35.23644 F1800
+G1 X137.027 Y109.600 E35.24306 F1800
+G1 X137.060 Y109.402 E35.24967 F1800
+G1 X137.107 Y109.207 E35.25629 F1800
+G1 X137.166 Y109.016 E35.26291 F1800
+G1 X137.238 Y108.829 E35.26952 F1800
+G1 X137.322 Y108.647 E35.27614 F1800
+G1 X137.419 Y108.471 E35.28275 F1800
+G1 X137.527 Y108.302 E35.28937 F1800
+G1 X137.646 Y108.141 E35.29599 F1800
+G1 X137.775 Y107.988 E35.30260 F1800
+G1 X137.914 Y107.844 E35.30922 F1800
+G1 X138.063 Y107.709 E35.31583 F1800
+G1 X138.220 Y107.585 E35.32245 F1800
+G1 X138.386 Y107.471 E35.32907 F1800
+G1 X138.558 Y107.369 E35.33568 F1800
+G1 X138.737 Y107.279 E35.34230 F1800
+G1 X138.922 Y107.200 E35.34892 F1800
+G1 X139.111 Y107.135 E35.35553 F1800
+G1 X139.305 Y107.082 E35.36215 F1800
+G1 X139.501 Y107.042 E35.36876 F1800
+G1 X139.700 Y107.015 E35.37538 F1800
+G1 X139.900 Y107.002 E35.38200 F1800
+G1 X140.100 Y107.002 E35.38861 F1800
+G1 X140.300 Y107.015 E35.39523 F1800
+G1 X140.499 Y107.042 E35.40184 F1800
+G1 X140.695 Y107.082 E35.40846 F1800
+G1 X140.889 Y107.135 E35.41508 F1800
+G1 X141.078 Y107.200 E35.42169 F1800
+G1 X141.263 Y107.279 E35.42831 F1800
+G1 X141.442 Y107.369 E35.43493 F1800
+G1 X141.614 Y107.471 E35.44154 F1800
+G1 X141.780 Y107.585 E35.44816 F1800
+G1 X141.937 Y107.709 E35.45477 F1800
+G1 X142.086 Y107.844 E35.46139 F1800
+G1 X142.225 Y107.988 E35.46801 F1800
+G1 X142.354 Y108.141 E35.47462 F1800
+G1 X142.473 Y108.302 E35.48124 F1800
+G1 X142.581 Y108.471 E35.48786 F1800
+G1 X142.678 Y108.647 E35.49447 F1800
+G1 X142.762 Y108.829 E35.50109 F1800
+G1 X142.834 Y109.016 E35.50770 F1800
+G1 X142.893 Y109.207 E35.51432 F1800
+G1 X142.940 Y109.402 E35.52094 F1800
+G1 X142.973 Y109.600 E35.52755 F1800
+G1 X142.993 Y109.800 E35.53417 F1800
+G1 X143.000 Y110.000 E35.54078 F1800
+G1 Z0.60 F600
+G1 E34.54078 F2400
+G0 X130.000 Y110.000 F6000
+G1 E35.54078 F2400
+G1 X129.975 Y110.997 E35.57369 F2400
+G1 X129.901 Y111.991 E35.60660 F2400
+G1 X129.777 Y112.981 E35.63951 F2400
+G1 X129.603 Y113.963 E35.67242 F2400
+G1 X129.382 Y114.935 E35.70533 F2400
+G1 X129.111 Y115.895 E35.73824 F2400
+G1 X128.794 Y116.840 E35.77114 F2400
+G1 X128.430 Y117.769 E35.80405 F2400
+G1 X128.019 Y118.678 E35.83696 F2400
+G1 X127.564 Y119.565 E35.86987 F2400
+G1 X127.066 Y120.429 E35.90278 F2400
+G1 X126.525 Y121.266 E35.93569 F2400
+G1 X125.943 Y122.076 E35.96860 F2400
+G1 X125.321 Y122.856 E36.00150 F2400
+G1 X124.661 Y123.603 E36.03441 F2400
+G1 X123.965 Y124.317 E36.06732 F2400
+G1 X123.234 Y124.996 E36.10023 F2400
+G1 X122.470 Y125.637 E36.13314 F2400
+G1 X121.675 Y126.239 E36.16605 F2400
+G1 X120.851 Y126.801 E36.19895 F2400
+G1 X120.000 Y127.321 E36.23186 F2400
+G1 X119.124 Y127.797 E36.26477 F2400
+G1 X118.226 Y128.230 E36.29768 F2400
+G1 X117.307 Y128.617 E36.33059 F2400
+G1 X116.370 Y128.959 E36.36350 F2400
+G1 X115.417 Y129.252 E36.39641 F2400
+G1 X114.450 Y129.499 E36.42931 F2400
+G1 X113.473 Y129.696 E36.46222 F2400
+G1 X112.487 Y129.845 E36.49513 F2400
+G1 X111.495 Y129.944 E36.52804 F2400
+G1 X110.499 Y129.994 E36.56095 F2400
+G1 X109.501 Y129.994 E36.59386 F2400
+G1 X108.505 Y129.944 E36.62677 F2400
+G1 X107.513 Y129.845 E36.65967 F2400
+G1 X106.527 Y129.696 E36.69258 F2400
+G1 X105.550 Y129.499 E36.72549 F2400
+G1 X104.583 Y129.252 E36.75840 F2400
+G1 X103.630 Y128.959 E36.79131 F2400
+G1 X102.693 Y128.617 E36.82422 F2400
+G1 X101.774 Y128.230 E36.85712 F2400
+G1 X100.876 Y127.797 E36.89003 F2400
+G1 X100.000 Y127.321 E36.92294 F2400
+G1 X99.149 Y126.801 E36.95585 F2400
+G1 X98.325 Y126.239 E36.98876 F2400
+G1 X97.530 Y125.637 E37.02167 F2400
+G1 X96.766 Y124.996 E37.05458 F2400
+G1 X96.035 Y124.317 E37.08748 F2400
+G1 X95.339 Y123.603 E37.12039 F2400
+G1 X94.679 Y122.856 E37.15330 F2400
+G1 X94.057 Y122.076 E37.18621 F2400
+G1 X93.475 Y121.266 E37.21912 F2400
+G1 X92.934 Y120.429 E37.25203 F2400
+G1 X92.436 Y119.565 E37.28494 F2400
+G1 X91.981 Y118.678 E37.31784 F2400
+G1 X91.570 Y117.769 E37.35075 F2400
+G1 X91.206 Y116.840 E37.38366 F2400
+G1 X90.889 Y115.895 E37.41657 F2400
+G1 X90.618 Y114.935 E37.44948 F2400
+G1 X90.397 Y113.963 E37.48239 F2400
+G1 X90.223 Y112.981 E37.51530 F2400
+G1 X90.099 Y111.991 E37.54820 F2400
+G1 X90.025 Y110.997 E37.58111 F2400
+G1 X90.000 Y110.000 E37.61402 F2400
+G1 X90.025 Y109.003 E37.64693 F2400
+G1 X90.099 Y108.009 E37.67984 F2400
+G1 X90.223 Y107.019 E37.71275 F2400
+G1 X90.397 Y106.037 E37.74565 F2400
+G1 X90.618 Y105.065 E37.77856 F2400
+G1 X90.889 Y104.105 E37.81147 F2400
+G1 X91.206 Y103.160 E37.84438 F2400
+G1 X91.570 Y102.231 E37.87729 F2400
+G1 X91.981 Y101.322 E37.91020 F2400
+G1 X92.436 Y100.435 E37.94311 F2400
+G1 X92.934 Y99.571 E37.97601 F2400
+G1 X93.475 Y98.734 E38.00892 F2400
+G1 X94.057 Y97.924 E38.04183 F2400
+G1 X94.679 Y97.144 E38.07474 F2400
+G1 X95.339 Y96.397 E38.10765 F2400
+G1 X96.035 Y95.683 E38.14056 F2400
+G1 X96.766 Y95.004 E38.17347 F2400
+G1 X97.530 Y94.363 E38.20637 F2400
+G1 X98.325 Y93.761 E38.23928 F2400
+G1 X99.149 Y93.199 E38.27219 F2400
+G1 X100.000 Y92.679 E38.30510 F2400
+G1 X100.876 Y92.203 E38.33801 F2400
+G1 X101.774 Y91.770 E38.37092 F2400
+G1 X102.693 Y91.383 E38.40383 F2400
+G1 X103.630 Y91.041 E38.43673 F2400
+G1 X104.583 Y90.748 E38.46964 F2400
+G1 X105.550 Y90.501 E38.50255 F2400
+G1 X106.527 Y90.304 E38.53546 F2400
+G1 X107.513 Y90.155 E38.56837 F2400
+G1 X108.505 Y90.056 E38.60128 F2400
+G1 X109.501 Y90.006 E38.63418 F2400
+G1 X110.499 Y90.006 E38.66709 F2400
+G1 X111.495 Y90.056 E38.70000 F2400
+G1 X112.487 Y90.155 E38.73291 F2400
+G1 X113.473 Y90.304 E38.76582 F2400
+G1 X114.450 Y90.501 E38.79873 F2400
+G1 X115.417 Y90.748 E38.83164 F2400
+G1 X116.370 Y91.041 E38.86454 F2400
+G1 X117.307 Y91.383 E38.89745 F2400
+G1 X118.226 Y91.770 E38.93036 F2400
+G1 X119.124 Y92.203 E38.96327 F2400
+G1 X120.000 Y92.679 E38.99618 F2400
+G1 X120.851 Y93.199 E39.02909 F2400
+G1 X121.675 Y93.761 E39.06200 F2400
+G1 X122.470 Y94.363 E39.09490 F2400
+G1 X123.234 Y95.004 E39.12781 F2400
+G1 X123.965 Y95.683 E39.16072 F2400
+G1 X124.661 Y96.397 E39.19363 F2400
+G1 X125.321 Y97.144 E39.22654 F2400
+G1 X125.943 Y97.924 E39.25945 F2400
+G1 X126.525 Y98.734 E39.29235 F2400
+G1 X127.066 Y99.571 E39.32526 F2400
+G1 X127.564 Y100.435 E39.35817 F2400
+G1 X128.019 Y101.322 E39.39108 F2400
+G1 X128.430 Y102.231 E39.42399 F2400
+G1 X128.794 Y103.160 E39.45690 F2400
+G1 X129.111 Y104.105 E39.48981 F2400
+G1 X129.382 Y105.065 E39.52271 F2400
+G1 X129.603 Y106.037 E39.55562 F2400
+G1 X129.777 Y107.019 E39.58853 F2400
+G1 X129.901 Y108.009 E39.62144 F2400
+G1 X129.975 Y109.003 E39.65435 F2400
+G1 X130.000 Y110.000 E39.68726 F2400
+G1 E38.68726 F2400
+G0 X98.000 Y98.000 F6000
+G1 E39.68726 F2400
+G1 X122.000 Y98.000 E40.47926 F3000
+G1 X122.000 Y122.000 E41.27126 F3000
+G1 X98.000 Y122.000 E42.06326 F3000
+G1 X98.000 Y98.000 E42.85526 F3000
+G1 E41.85526 F2400
+G0 X99.000 Y98.500 F6000
+G1 E42.85526 F2400
+G1 X99.000 Y121.500 E43.61426 F4800
+G1 X101.000 Y121.500 E43.68026 F4800
+G1 X101.000 Y98.500 E44.43926 F4800
+G1 X103.000 Y98.500 E44.50526 F4800
+G1 X103.000 Y121.500 E45.26426 F4800
+G1 X105.000 Y121.500 E45.33026 F4800
+G1 X105.000 Y98.500 E46.08926 F4800
+G1 X107.000 Y98.500 E46.15526 F4800
+G1 X107.000 Y121.500 E46.91426 F4800
+G1 X109.000 Y121.500 E46.98026 F4800
+G1 X109.000 Y98.500 E47.73926 F4800
+G1 X111.000 Y98.500 E47.80526 F4800
+G1 X111.000 Y121.500 E48.56426 F4800
+G1 X113.000 Y121.500 E48.63026 F4800
+G1 X113.000 Y98.500 E49.38926 F4800
+G1 X115.000 Y98.500 E49.45526 F4800
+G1 X115.000 Y121.500 E50.21426 F4800
+G1 X117.000 Y121.500 E50.28026 F4800
+G1 X117.000 Y98.500 E51.03926 F4800
+G1 X119.000 Y98.500 E51.10526 F4800
+G1 X119.000 Y121.500 E51.86426 F4800
+G1 X121.000 Y121.500 E51.93026 F4800
+G1 X121.000 Y98.500 E52.68926 F4800
+G1 E51.68926 F2400
+G0 X143.000 Y110.000 F6000
+G1 E52.68926 F2400
+G1 X142.993 Y110.200 E52.69587 F1800
+G1 X142.973 Y110.400 E52.70249 F1800
+G1 X142.940 Y110.598 E52.70911 F1800
+G1 X142.893 Y110.793 E52.71572 F1800
+G1 X142.834 Y110.984 E52.72234 F1800
+G1 X142.762 Y111.171 E52.72895 F1800
+G1 X142.678 Y111.353 E52.73557 F1800
+G1 X142.581 Y111.529 E52.74219 F1800
+G1 X142.473 Y111.698 E52.74880 F1800
+G1 X142.354 Y111.859 E52.75542 F1800
+G1 X142.225 Y112.012 E52.76203 F1800
+G1 X142.086 Y112.156 E52.76865 F1800
+G1 X141.937 Y112.291 E52.77527 F1800
+G1 X141.780 Y112.415 E52.78188 F1800
+G1 X141.614 Y112.529 E52.78850 F1800
+G1 X141.442 Y112.631 E52.79512 F1800
+G1 X141.263 Y112.721 E52.80173 F1800
+G1 X141.078 Y112.800 E52.80835 F1800
+G1 X140.889 Y112.865 E52.81496 F1800
+G1 X140.695 Y112.918 E52.82158 F1800
+G1 X140.499 Y112.958 E52.82820 F1800
+G1 X140.300 Y112.985 E52.83481 F1800
+G1 X140.100 Y112.998 E52.84143 F1800
+G1 X139.900 Y112.998 E52.84805 F1800
+G1 X139.700 Y112.985 E52.85466 F1800
+G1 X139.501 Y112.958 E52.86128 F1800
+G1 X139.305 Y112.918 E52.86789 F1800
+G1 X139.111 Y112.865 E52.87451 F1800
+G1 X138.922 Y112.800 E52.88113 F1800
+G1 X138.737 Y112.721 E52.88774 F1800
+G1 X138.558 Y112.631 E52.89436 F1800
+G1 X138.386 Y112.529 E52.90097 F1800
+G1 X138.220 Y112.415 E52.90759 F1800
+G1 X138.063 Y112.291 E52.91421 F1800
+G1 X137.914 Y112.156 E52.92082 F1800
+G1 X137.775 Y112.012 E52.92744 F1800
+G1 X137.646 Y111.859 E52.93406 F1800
+G1 X137.527 Y111.698 E52.94067 F1800
+G1 X137.419 Y111.529 E52.94729 F1800
+G1 X137.322 Y111.353 E52.95390 F1800
+G1 X137.238 Y111.171 E52.96052 F1800
+G1 X137.166 Y110.984 E52.96714 F1800
+G1 X137.107 Y110.793 E52.97375 F1800
+G1 X137.060 Y110.598 E52.98037 F1800
+G1 X137.027 Y110.400 E52.98698 F1800
+G1 X137.007 Y110.200 E52.99360 F1800
+G1 X137.000 Y110.000 E53.00022 F1800
+G1 X137.007 Y109.800 E53.00683 F1800
+G1 X137.027 Y109.600 E53.01345 F1800
+G1 X137.060 Y109.402 E53.02007 F1800
+G1 X137.107 Y109.207 E53.02668 F1800
+G1 X137.166 Y109.016 E53.03330 F1800
+G1 X137.238 Y108.829 E53.03991 F1800
+G1 X137.322 Y108.647 E53.04653 F1800
+G1 X137.419 Y108.471 E53.05315 F1800
+G1 X137.527 Y108.302 E53.05976 F1800
+G1 X137.646 Y108.141 E53.06638 F1800
+G1 X137.775 Y107.988 E53.07299 F1800
+G1 X137.914 Y107.844 E53.07961 F1800
+G1 X138.063 Y107.709 E53.08623 F1800
+G1 X138.220 Y107.585 E53.09284 F1800
+G1 X138.386 Y107.471 E53.09946 F1800
+G1 X138.558 Y107.369 E53.10608 F1800
+G1 X138.737 Y107.279 E53.11269 F1800
+G1 X138.922 Y107.200 E53.11931 F1800
+G1 X139.111 Y107.135 E53.12592 F1800
+G1 X139.305 Y107.082 E53.13254 F1800
+G1 X139.501 Y107.042 E53.13916 F1800
+G1 X139.700 Y107.015 E53.14577 F1800
+G1 X139.900 Y107.002 E53.15239 F1800
+G1 X140.100 Y107.002 E53.15900 F1800
+G1 X140.300 Y107.015 E53.16562 F1800
+G1 X140.499 Y107.042 E53.17224 F1800
+G1 X140.695 Y107.082 E53.17885 F1800
+G1 X140.889 Y107.135 E53.18547 F1800
+G1 X141.078 Y107.200 E53.19209 F1800
+G1 X141.263 Y107.279 E53.19870 F1800
+G1 X141.442 Y107.369 E53.20532 F1800
+G1 X141.614 Y107.471 E53.21193 F1800
+G1 X141.780 Y107.585 E53.21855 F1800
+G1 X141.937 Y107.709 E53.22517 F1800
+G1 X142.086 Y107.844 E53.23178 F1800
+G1 X142.225 Y107.988 E53.23840 F1800
+G1 X142.354 Y108.141 E53.24501 F1800
+G1 X142.473 Y108.302 E53.25163 F1800
+G1 X142.581 Y108.471 E53.25825 F1800
+G1 X142.678 Y108.647 E53.26486 F1800
+G1 X142.762 Y108.829 E53.27148 F1800
+G1 X142.834 Y109.016 E53.27810 F1800
+G1 X142.893 Y109.207 E53.28471 F1800
+G1 X142.940 Y109.402 E53.29133 F1800
+G1 X142.973 Y109.600 E53.29794 F1800
+G1 X142.993 Y109.800 E53.30456 F1800
+G1 X143.000 Y110.000 E53.31118 F1800
+G1 Z10 F600
+M400